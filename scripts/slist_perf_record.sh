@@ -0,0 +1,22 @@
+#!/bin/sh
+#
+# Records every slist USDT probe of a program built with SLIST_ENABLE_USDT
+# using perf, then prints the trace.
+#
+# Usage: slist_perf_record.sh <program> [args...]
+#
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <program> [args...]" >&2
+    exit 1
+fi
+
+perf buildid-cache --add "$1"
+for probe in add_begin add duplicate pop walk_begin walk_end; do
+    perf probe --quiet --add "sdt_slist:$probe" 2>/dev/null || true
+done
+
+perf record -e 'sdt_slist:*' -o slist_perf.data -- "$@"
+perf script -i slist_perf.data
@@ -0,0 +1,287 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_arena_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Arena allocator for dynamic list nodes in hosted builds
+ *
+ * @details
+ *
+ *	An arena hands out nodes of any list<T> from large chunks by bumping a
+ *	pointer, so consecutive nodes are contiguous in memory and allocating is
+ *	a compare and an add. Nodes are never freed one by one: all of them are
+ *	released at once when the lists using them are no longer needed.
+ *
+ *	- SLIST_ARENA_RESET rewinds the arena in O(1), keeping its chunks to be
+ *	  reused by the next allocations
+ *	- SLIST_ARENA_DESTROY gives the chunks back to the system, one call per
+ *	  chunk whatever the number of nodes
+ *
+ *	Chunks come from malloc, or from mmap with MADV_HUGEPAGE when created with
+ *	SLIST_ARENA_HUGEPAGES, so that a long list is covered by a few TLB entries.
+ *	The latter needs Linux and _GNU_SOURCE (or _DEFAULT_SOURCE) defined before
+ *	any include, otherwise malloc is used silently.
+ *
+ *	The arena is not tied to a type and needs no instantiation, a single one
+ *	may serve lists of different types:
+ *
+ *		SLIST_CREATE_ARENA(arena, 1 << 21, SLIST_ARENA_HUGEPAGES);
+ *		SLIST_CREATE_LIST(uint32_t, list);
+ *
+ *		SLIST_NODE(uint32_t)* node = SLIST_ARENA_ALLOC(uint32_t, arena);	// NULL if out of memory
+ *		node->data = 7;
+ *		SLIST_ADD_NODE_PTR(uint32_t, list, node);
+ *		...
+ *		list = NULL;
+ *		SLIST_ARENA_DESTROY(arena);
+ *
+ *	This module needs a hosted environment (malloc), unlike the list itself.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_ARENA_TEMPLATE_H_
+#define SLIST_ARENA_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+#include <stdint.h>
+#include <stdlib.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/*****************************************************************************
+ * CONFIGURATION
+ ****************************************************************************/
+
+/*
+ * Minimum alignment of every allocation, a power of two. Nodes needing more
+ * (SLIST_LAYOUT_ALIGNED, over aligned T) are aligned to what their type
+ * needs, skipping the bytes up to the next boundary.
+ */
+#ifndef SLIST_ARENA_ALIGNMENT
+#define SLIST_ARENA_ALIGNMENT 16u
+#endif
+
+SLIST_STATIC_ASSERT((SLIST_ARENA_ALIGNMENT & (SLIST_ARENA_ALIGNMENT - 1)) == 0, sSLIST_ArenaAlignmentIsPowerOfTwo);
+
+#if defined(MAP_ANONYMOUS) && defined(MADV_HUGEPAGE)
+#define SLIST_ARENA_HAS_HUGEPAGES 1
+#define SLIST_ARENA_HUGEPAGE_SIZE ((size_t)2u << 20)
+#else
+#define SLIST_ARENA_HAS_HUGEPAGES 0
+#endif
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Usage:
+ *
+ *	SLIST_CREATE_ARENA(arena, chunkSize, flags);	// flags: 0 or SLIST_ARENA_HUGEPAGES
+ *	SLIST_ARENA_ALLOC(T, arena)				// node<T>*, uninitialized and aligned, or NULL
+ *	SLIST_ARENA_RESET(arena)				// all nodes released, chunks kept, O(1)
+ *	SLIST_ARENA_DESTROY(arena)				// all nodes released, chunks freed
+ *	SLIST_ARENA_BYTES(arena)				// bytes reserved from the system
+ */
+
+#define SLIST_ARENA_HUGEPAGES 1u
+
+#define SLIST_ARENA \
+struct sSLIST_Arena
+
+#define SLIST_CREATE_ARENA(arena_, chunkSize_, flags_) \
+SLIST_ARENA arena_ = { NULL, NULL, NULL, NULL, (chunkSize_), (flags_), 0 }
+
+#define SLIST_ARENA_ALLOC(T, arena_) \
+((SLIST_NODE(T)*)SLIST_arena_alloc(&(arena_), sizeof(SLIST_NODE(T)), SLIST_ALIGNOF(SLIST_NODE(T))))
+
+#define SLIST_ARENA_RESET(arena_) \
+SLIST_arena_reset(&(arena_))
+
+#define SLIST_ARENA_DESTROY(arena_) \
+SLIST_arena_destroy(&(arena_))
+
+#define SLIST_ARENA_BYTES(arena_) \
+((arena_).bytes)
+
+/*
+ * The arena itself
+ *
+ * Chunks are kept in allocation order, the arena bumping `cursor` up to
+ * `end` inside `current`. Once a chunk is exhausted the next one in the list
+ * is reused if there is one (after a reset), otherwise a new one is linked
+ * after it.
+ */
+
+struct sSLIST_ArenaChunk {
+    struct sSLIST_ArenaChunk* next;
+    size_t size;
+    int mapped;
+};
+
+SLIST_ARENA {
+    struct sSLIST_ArenaChunk* first;
+    struct sSLIST_ArenaChunk* current;
+    char* cursor;
+    char* end;
+    size_t chunkSize;
+    unsigned flags;
+    size_t bytes;
+};
+
+#define SLIST_ARENA_ROUND_UP(size_, alignment_) \
+(((size_) + (alignment_) - 1) & ~((size_t)(alignment_) - 1))
+
+#define SLIST_ARENA_CHUNK_HEADER \
+SLIST_ARENA_ROUND_UP(sizeof(struct sSLIST_ArenaChunk), SLIST_ARENA_ALIGNMENT)
+
+static inline struct sSLIST_ArenaChunk* SLIST_arena_new_chunk(SLIST_ARENA* arena, size_t size)
+{
+    struct sSLIST_ArenaChunk* chunk = NULL;
+    int mapped = 0;
+#if SLIST_ARENA_HAS_HUGEPAGES
+    if (arena->flags & SLIST_ARENA_HUGEPAGES)
+    {
+        size = SLIST_ARENA_ROUND_UP(size, SLIST_ARENA_HUGEPAGE_SIZE);
+        void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory != MAP_FAILED)
+        {
+            /* Only a hint, the chunk is still usable with regular pages */
+            (void)madvise(memory, size, MADV_HUGEPAGE);
+            chunk = memory;
+            mapped = 1;
+        }
+    }
+#endif
+    if (chunk == NULL)
+    {
+        chunk = malloc(size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+    }
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->mapped = mapped;
+    arena->bytes += size;
+    return chunk;
+}
+
+static inline void SLIST_arena_free_chunk(struct sSLIST_ArenaChunk* chunk)
+{
+#if SLIST_ARENA_HAS_HUGEPAGES
+    if (chunk->mapped)
+    {
+        munmap(chunk, chunk->size);
+        return;
+    }
+#endif
+    free(chunk);
+}
+
+static inline void SLIST_arena_enter(SLIST_ARENA* arena, struct sSLIST_ArenaChunk* chunk)
+{
+    arena->current = chunk;
+    arena->cursor = (char*)chunk + SLIST_ARENA_CHUNK_HEADER;
+    arena->end = (char*)chunk + chunk->size;
+}
+
+static inline int SLIST_arena_grow(SLIST_ARENA* arena, size_t size)
+{
+    size_t header = SLIST_ARENA_CHUNK_HEADER;
+    struct sSLIST_ArenaChunk* chunk;
+    /* Skip the kept chunks that are too small for this allocation */
+    chunk = (arena->current != NULL) ? arena->current->next : arena->first;
+    while (chunk != NULL && chunk->size - header < size)
+    {
+        chunk = chunk->next;
+    }
+    if (chunk == NULL)
+    {
+        size_t chunkSize = (arena->chunkSize > header + size) ? arena->chunkSize : header + size;
+        chunk = SLIST_arena_new_chunk(arena, chunkSize);
+        if (chunk == NULL)
+        {
+            return 0;
+        }
+        if (arena->current == NULL)
+        {
+            chunk->next = arena->first;
+            arena->first = chunk;
+        }
+        else
+        {
+            chunk->next = arena->current->next;
+            arena->current->next = chunk;
+        }
+    }
+    SLIST_arena_enter(arena, chunk);
+    return 1;
+}
+
+/*
+ * A fresh chunk is asked for alignment - 1 bytes more than the node, so that
+ * the node fits wherever the chunk starts.
+ */
+static inline void* SLIST_arena_alloc(SLIST_ARENA* arena, size_t size, size_t alignment)
+{
+    uintptr_t node;
+    size = SLIST_ARENA_ROUND_UP(size, SLIST_ARENA_ALIGNMENT);
+    if (alignment < SLIST_ARENA_ALIGNMENT)
+    {
+        alignment = SLIST_ARENA_ALIGNMENT;
+    }
+    node = SLIST_ARENA_ROUND_UP((uintptr_t)arena->cursor, alignment);
+    if (node > (uintptr_t)arena->end || (uintptr_t)arena->end - node < size)
+    {
+        if (!SLIST_arena_grow(arena, size + alignment - 1))
+        {
+            return NULL;
+        }
+        node = SLIST_ARENA_ROUND_UP((uintptr_t)arena->cursor, alignment);
+    }
+    arena->cursor = (char*)node + size;
+    return (void*)node;
+}
+
+static inline void SLIST_arena_reset(SLIST_ARENA* arena)
+{
+    arena->current = NULL;
+    arena->cursor = NULL;
+    arena->end = NULL;
+}
+
+static inline void SLIST_arena_destroy(SLIST_ARENA* arena)
+{
+    struct sSLIST_ArenaChunk* chunk = arena->first;
+    while (chunk != NULL)
+    {
+        struct sSLIST_ArenaChunk* next = chunk->next;
+        SLIST_arena_free_chunk(chunk);
+        chunk = next;
+    }
+    arena->first = NULL;
+    arena->bytes = 0;
+    SLIST_arena_reset(arena);
+}
+
+#endif /* SLIST_ARENA_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
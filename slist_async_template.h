@@ -0,0 +1,282 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_async_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C++20
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Awaitable FIFO queue of list nodes for C++20 coroutines
+ *
+ * @details
+ *
+ *	A queue of SLIST_NODE(T) that coroutines pop with co_await, suspending
+ *	while it is empty. Suspended coroutines are themselves linked as list
+ *	nodes: the waiter node lives in the awaiter, which the compiler keeps in
+ *	the coroutine frame, so suspending allocates nothing. A push with
+ *	coroutines waiting hands the node to the oldest one and resumes it right
+ *	away, on the stack of the producer, before push returns.
+ *
+ *	Both items and waiters are kept in FIFO order with head and tail pointers,
+ *	so push, pop and resume are O(1). The queue is not thread safe: it is
+ *	meant for coroutines sharing a single-threaded executor (an event loop),
+ *	producers included.
+ *
+ *	The queue is instantiated per type after the list:
+ *
+ *		```
+ *		SLIST_DECLARE(sJob)
+ *		SLIST_ASYNC_DECLARE(sJob)
+ *		```
+ *
+ *	Usage:
+ *
+ *		SLIST_ASYNC_QUEUE(sJob) jobs;
+ *
+ *		producer: SLIST_ASYNC_PUSH(sJob, jobs, node);
+ *		consumer: SLIST_NODE(sJob)* job = co_await SLIST_ASYNC_POP(sJob, jobs);
+ *
+ *	A pushed node belongs to the queue until it is popped. The queue does not
+ *	own the waiting coroutines: destroying it with coroutines waiting leaves
+ *	them suspended, it is up to their owner to destroy them. Destroying a
+ *	suspended coroutine takes its waiter out of the queue, in O(waiters), so
+ *	a later push goes to the next waiter instead.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_ASYNC_TEMPLATE_H_
+#define SLIST_ASYNC_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+
+#if !defined(__cplusplus) || __cplusplus < 202002L
+#error "slist_async_template.h needs C++20 coroutines"
+#endif
+
+#include <coroutine>
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use SLIST_ASYNC_DECLARE(T) in a C++ header or module, after the list of T
+ * has been declared. Everything is defined inline, there is no definition.
+ */
+
+#define SLIST_ASYNC_DECLARE(T) \
+SLIST_ASYNC_DECLARE_WAITER(T); \
+SLIST_DECLARE_NODE_TYPE(SLIST_ASYNC_WAITER(T)); \
+SLIST_ASYNC_DECLARE_QUEUE(T)
+
+/*
+ * Usage:
+ *
+ *	SLIST_ASYNC_PUSH(T, queue, node)		// hands node<T> to a waiter, or queues it
+ *	SLIST_ASYNC_TRY_POP(T, queue)			// node<T>* or NULL, never suspends
+ *	co_await SLIST_ASYNC_POP(T, queue)		// node<T>*, suspends while empty
+ *	SLIST_ASYNC_WAITING(T, queue)			// number of suspended coroutines
+ */
+
+#define SLIST_ASYNC_QUEUE(T) \
+sSLIST_##T##_AsyncQueue
+
+#define SLIST_ASYNC_PUSH(T, queue_, node_) \
+(queue_).push(&(node_))
+
+#define SLIST_ASYNC_PUSH_PTR(T, queue_, node_) \
+(queue_).push(node_)
+
+#define SLIST_ASYNC_TRY_POP(T, queue_) \
+(queue_).try_pop()
+
+#define SLIST_ASYNC_POP(T, queue_) \
+(queue_).pop()
+
+#define SLIST_ASYNC_WAITING(T, queue_) \
+(queue_).waiting()
+
+/*
+ * The templates themselves
+ *
+ * Items and waiters are never queued at the same time: push only queues an
+ * item when nobody waits, and a pop only waits when there are no items.
+ */
+
+#define SLIST_ASYNC_WAITER(T) \
+sSLIST_##T##_AsyncWaiter
+
+/* Expands the waiter name before SLIST_NODE pastes it */
+#define SLIST_ASYNC_NODE(W) \
+SLIST_NODE(W)
+
+#define SLIST_ASYNC_DECLARE_WAITER(T) \
+struct SLIST_ASYNC_WAITER(T) { \
+    std::coroutine_handle<> handle; \
+    SLIST_NODE(T)* item; \
+}
+
+#define SLIST_ASYNC_DECLARE_QUEUE(T) \
+class SLIST_ASYNC_QUEUE(T) \
+{ \
+public: \
+    class Pop \
+    { \
+    public: \
+        explicit Pop(SLIST_ASYNC_QUEUE(T)& queue) : queue_(queue), waiter_() {} \
+        Pop(const Pop&) = delete; \
+        Pop& operator=(const Pop&) = delete; \
+        /* The handle is only set while queued: push clears it before resuming */ \
+        ~Pop() \
+        { \
+            if (waiter_.data.handle) \
+            { \
+                queue_.unwait(&waiter_); \
+            } \
+        } \
+        bool await_ready() \
+        { \
+            waiter_.data.item = queue_.try_pop(); \
+            return waiter_.data.item != NULL; \
+        } \
+        void await_suspend(std::coroutine_handle<> handle) \
+        { \
+            waiter_.data.handle = handle; \
+            queue_.wait(&waiter_); \
+        } \
+        SLIST_NODE(T)* await_resume() const \
+        { \
+            return waiter_.data.item; \
+        } \
+    private: \
+        SLIST_ASYNC_QUEUE(T)& queue_; \
+        SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T)) waiter_; \
+    }; \
+    \
+    SLIST_ASYNC_QUEUE(T)() = default; \
+    SLIST_ASYNC_QUEUE(T)(const SLIST_ASYNC_QUEUE(T)&) = delete; \
+    SLIST_ASYNC_QUEUE(T)& operator=(const SLIST_ASYNC_QUEUE(T)&) = delete; \
+    \
+    void push(SLIST_NODE(T)* node) \
+    { \
+        SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* waiter = waitersHead_; \
+        if (waiter != NULL) \
+        { \
+            waitersHead_ = waiter->next; \
+            if (waitersHead_ == NULL) \
+            { \
+                waitersTail_ = NULL; \
+            } \
+            waitersCount_--; \
+            waiter->next = NULL; \
+            waiter->data.item = node; \
+            std::coroutine_handle<> handle = waiter->data.handle; \
+            waiter->data.handle = nullptr; \
+            /* The waiter lives in the frame being resumed: not touched after */ \
+            handle.resume(); \
+            return; \
+        } \
+        node->next = NULL; \
+        if (itemsTail_ != NULL) \
+        { \
+            itemsTail_->next = node; \
+        } \
+        else \
+        { \
+            itemsHead_ = node; \
+        } \
+        itemsTail_ = node; \
+    } \
+    \
+    SLIST_NODE(T)* try_pop() \
+    { \
+        SLIST_NODE(T)* node = itemsHead_; \
+        if (node != NULL) \
+        { \
+            itemsHead_ = node->next; \
+            if (itemsHead_ == NULL) \
+            { \
+                itemsTail_ = NULL; \
+            } \
+            node->next = NULL; \
+        } \
+        return node; \
+    } \
+    \
+    Pop pop() \
+    { \
+        return Pop(*this); \
+    } \
+    \
+    size_t waiting() const \
+    { \
+        return waitersCount_; \
+    } \
+    \
+private: \
+    void wait(SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* waiter) \
+    { \
+        waiter->next = NULL; \
+        if (waitersTail_ != NULL) \
+        { \
+            waitersTail_->next = waiter; \
+        } \
+        else \
+        { \
+            waitersHead_ = waiter; \
+        } \
+        waitersTail_ = waiter; \
+        waitersCount_++; \
+    } \
+    \
+    void unwait(SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* waiter) \
+    { \
+        SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* prev = NULL; \
+        SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* node = waitersHead_; \
+        while (node != NULL && node != waiter) \
+        { \
+            prev = node; \
+            node = node->next; \
+        } \
+        if (node == NULL) \
+        { \
+            return; \
+        } \
+        if (prev != NULL) \
+        { \
+            prev->next = waiter->next; \
+        } \
+        else \
+        { \
+            waitersHead_ = waiter->next; \
+        } \
+        if (waitersTail_ == waiter) \
+        { \
+            waitersTail_ = prev; \
+        } \
+        waitersCount_--; \
+        waiter->next = NULL; \
+    } \
+    \
+    SLIST_NODE(T)* itemsHead_ = NULL; \
+    SLIST_NODE(T)* itemsTail_ = NULL; \
+    SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* waitersHead_ = NULL; \
+    SLIST_ASYNC_NODE(SLIST_ASYNC_WAITER(T))* waitersTail_ = NULL; \
+    size_t waitersCount_ = 0; \
+}
+
+#endif /* SLIST_ASYNC_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
@@ -0,0 +1,212 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_batch_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Batched deferred work queue over the single list template
+ *
+ * @details
+ *
+ *	A batch collects nodes in FIFO order and hands all of them at once to a
+ *	flush callback, so that the work (and the cache warmth, and the system
+ *	calls) of processing them is shared. The batch is flushed as soon as any
+ *	of its thresholds is crossed:
+ *
+ *	- count: number of nodes collected
+ *	- bytes: sum of the sizes given when adding the nodes
+ *	- delay: time elapsed since the oldest node was added
+ *
+ *	A threshold set to 0 is disabled. Time is provided by the caller, in any
+ *	unit and from any monotonic clock, so the batch does not depend on any
+ *	timer. The delay is only checked when adding or polling, so it has to be
+ *	polled periodically when producers may stay idle.
+ *
+ *	The batch has to be instantiated like the list itself, after it:
+ *
+ *		```
+ *		SLIST_DECLARE(uint32_t)
+ *		SLIST_BATCH_DECLARE(uint32_t)
+ *		...
+ *		SLIST_DEFINE(uint32_t)
+ *		SLIST_BATCH_DEFINE(uint32_t)
+ *		```
+ *
+ *	Usage:
+ *
+ *		void process(SLIST_NODE(uint32_t)* batch, size_t count, void* context)
+ *		{
+ *			SLIST_FOR_EACH_NODE_PTR(uint32_t, batch, node) { ... }
+ *		}
+ *
+ *		SLIST_CREATE_BATCH(uint32_t, batch, 64, 4096, 100, process, NULL);
+ *		SLIST_BATCH_ADD(uint32_t, batch, node, sizeof(node.data), now);
+ *		SLIST_BATCH_POLL(uint32_t, batch, now);		// flushes if overdue
+ *		SLIST_BATCH_FLUSH(uint32_t, batch);			// flushes unconditionally
+ *
+ *	The batch is reset before the callback is called, so the callback owns
+ *	the nodes handed to it and may add new ones to the same batch. Adding is
+ *	O(1) and does not check for repetition, the node must not be on any list.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_BATCH_TEMPLATE_H_
+#define SLIST_BATCH_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+#include <stdint.h>
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use either:
+ *
+ * - SLIST_BATCH_DECLARE(T) in a C header: for public declaration
+ * - SLIST_BATCH_DECLARE_STATIC(T) in a C module: for private declaration
+ */
+
+#define SLIST_BATCH_DECLARE(T) \
+SLIST_BATCH_DECLARE_WITH_STORAGE(T, extern)
+
+#define SLIST_BATCH_DECLARE_STATIC(T) \
+SLIST_BATCH_DECLARE_WITH_STORAGE(T, static)
+
+/*
+ * Use either:
+ *
+ * - SLIST_BATCH_DEFINE(T) in a C module: for public definition
+ * - SLIST_BATCH_DEFINE_STATIC(T) in a C module: for private definition
+ */
+
+#define SLIST_BATCH_DEFINE(T) \
+SLIST_BATCH_DEFINE_WITH_STORAGE(T, )
+
+#define SLIST_BATCH_DEFINE_STATIC(T) \
+SLIST_BATCH_DEFINE_WITH_STORAGE(T, static)
+
+/*
+ * Usage:
+ *
+ *	SLIST_CREATE_BATCH(T, batch, maxCount, maxBytes, maxDelay, flush, context);
+ *	SLIST_BATCH_ADD(T, batch, node, bytes, now)	// 1 if it caused a flush
+ *	SLIST_BATCH_POLL(T, batch, now)				// 1 if it caused a flush
+ *	SLIST_BATCH_FLUSH(T, batch)					// 1 if there was something to flush
+ *	SLIST_BATCH_COUNT(batch)
+ *	SLIST_BATCH_BYTES(batch)
+ */
+
+#define SLIST_BATCH(T) \
+struct sSLIST_##T##_Batch
+
+#define SLIST_CREATE_BATCH(T, batch_, maxCount_, maxBytes_, maxDelay_, flush_, context_) \
+SLIST_BATCH(T) batch_ = { NULL, NULL, 0, 0, 0, (maxCount_), (maxBytes_), (maxDelay_), (flush_), (context_) }
+
+#define SLIST_BATCH_ADD(T, batch_, node_, bytes_, now_) \
+SLIST_batch_add_##T(&(batch_), &(node_), (bytes_), (now_))
+
+#define SLIST_BATCH_ADD_PTR(T, batch_, node_, bytes_, now_) \
+SLIST_batch_add_##T(&(batch_), (node_), (bytes_), (now_))
+
+#define SLIST_BATCH_POLL(T, batch_, now_) \
+SLIST_batch_poll_##T(&(batch_), (now_))
+
+#define SLIST_BATCH_FLUSH(T, batch_) \
+SLIST_batch_flush_##T(&(batch_))
+
+#define SLIST_BATCH_COUNT(batch_) \
+((batch_).count)
+
+#define SLIST_BATCH_BYTES(batch_) \
+((batch_).bytes)
+
+/*
+ * The templates themselves
+ */
+
+#define SLIST_BATCH_DECLARE_WITH_STORAGE(T, storage_) \
+SLIST_BATCH(T) { \
+    SLIST_NODE(T)* head; \
+    SLIST_NODE(T)* tail; \
+    size_t count; \
+    size_t bytes; \
+    uint64_t since; \
+    size_t maxCount; \
+    size_t maxBytes; \
+    uint64_t maxDelay; \
+    void (*flush)(SLIST_NODE(T)* batch, size_t count, void* context); \
+    void* context; \
+}; \
+storage_ int SLIST_batch_flush_##T(SLIST_BATCH(T)* batch); \
+storage_ int SLIST_batch_poll_##T(SLIST_BATCH(T)* batch, uint64_t now); \
+storage_ int SLIST_batch_add_##T(SLIST_BATCH(T)* batch, SLIST_NODE(T)* node, size_t bytes, uint64_t now)
+
+#define SLIST_BATCH_DEFINE_WITH_STORAGE(T, storage_) \
+storage_ int SLIST_batch_flush_##T(SLIST_BATCH(T)* batch) \
+{ \
+    SLIST_NODE(T)* head = batch->head; \
+    size_t count = batch->count; \
+    if (head == NULL) \
+    { \
+        return 0; \
+    } \
+    batch->head = NULL; \
+    batch->tail = NULL; \
+    batch->count = 0; \
+    batch->bytes = 0; \
+    batch->flush(head, count, batch->context); \
+    return 1; \
+} \
+\
+storage_ int SLIST_batch_poll_##T(SLIST_BATCH(T)* batch, uint64_t now) \
+{ \
+    if (batch->head == NULL || batch->maxDelay == 0 || \
+        now - batch->since < batch->maxDelay) \
+    { \
+        return 0; \
+    } \
+    return SLIST_batch_flush_##T(batch); \
+} \
+\
+storage_ int SLIST_batch_add_##T(SLIST_BATCH(T)* batch, SLIST_NODE(T)* node, size_t bytes, uint64_t now) \
+{ \
+    node->next = NULL; \
+    if (batch->tail == NULL) \
+    { \
+        batch->head = node; \
+        batch->since = now; \
+    } \
+    else \
+    { \
+        batch->tail->next = node; \
+    } \
+    batch->tail = node; \
+    batch->count++; \
+    batch->bytes += bytes; \
+    SLIST_VALIDATE_LIST(T, batch->head); \
+    if ((batch->maxCount != 0 && batch->count >= batch->maxCount) || \
+        (batch->maxBytes != 0 && batch->bytes >= batch->maxBytes)) \
+    { \
+        return SLIST_batch_flush_##T(batch); \
+    } \
+    return SLIST_batch_poll_##T(batch, now); \
+}
+
+#endif /* SLIST_BATCH_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
@@ -0,0 +1,241 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_heap_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Intrusive pairing heap built over the single list template nodes
+ *
+ * @details
+ *
+ *	A min-heap for arbitrary keys (deadlines, costs...) that uses only client
+ *	provided memory. A heap node is a list node, whose `next` link chains the
+ *	siblings, plus a pointer to its first child:
+ *
+ *		SLIST_HEAP_NODE(T) { SLIST_NODE(T) link; SLIST_HEAP_NODE(T)* child; }
+ *
+ *	so once out of the heap the same node can be added to any list<T>
+ *	through its `link` field. Insert and meld are O(1), pop-min is amortized
+ *	O(log N) (two pass pairing).
+ *
+ *	The heap is instantiated per type after the list, the definition taking
+ *	the ordering: a function or macro LESS(const T* a, const T* b) returning
+ *	non zero when a has to come out before b.
+ *
+ *		```
+ *		SLIST_DECLARE(sTimer)
+ *		SLIST_HEAP_DECLARE(sTimer)
+ *		...
+ *		#define TIMER_LESS(a, b) ((a)->deadline < (b)->deadline)
+ *		SLIST_DEFINE(sTimer)
+ *		SLIST_HEAP_DEFINE(sTimer, TIMER_LESS)
+ *		```
+ *
+ *	Usage:
+ *
+ *		SLIST_CREATE_HEAP(sTimer, heap);
+ *		SLIST_HEAP_NODE(sTimer) timer;
+ *		timer.link.data.deadline = now + 100;
+ *		SLIST_HEAP_INSERT(sTimer, heap, timer);
+ *		SLIST_HEAP_NODE(sTimer)* first = SLIST_HEAP_POP_MIN(sTimer, heap);
+ *
+ *	Inserting does not check for repetition, the node must not be on any
+ *	heap or list.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_HEAP_TEMPLATE_H_
+#define SLIST_HEAP_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use either:
+ *
+ * - SLIST_HEAP_DECLARE(T) in a C header: for public declaration
+ * - SLIST_HEAP_DECLARE_STATIC(T) in a C module: for private declaration
+ */
+
+#define SLIST_HEAP_DECLARE(T) \
+SLIST_HEAP_DECLARE_WITH_STORAGE(T, extern)
+
+#define SLIST_HEAP_DECLARE_STATIC(T) \
+SLIST_HEAP_DECLARE_WITH_STORAGE(T, static)
+
+/*
+ * Use either:
+ *
+ * - SLIST_HEAP_DEFINE(T, LESS) in a C module: for public definition
+ * - SLIST_HEAP_DEFINE_STATIC(T, LESS) in a C module: for private definition
+ */
+
+#define SLIST_HEAP_DEFINE(T, LESS) \
+SLIST_HEAP_DEFINE_WITH_STORAGE(T, LESS, )
+
+#define SLIST_HEAP_DEFINE_STATIC(T, LESS) \
+SLIST_HEAP_DEFINE_WITH_STORAGE(T, LESS, static)
+
+/*
+ * Usage:
+ *
+ *	SLIST_CREATE_HEAP(T, heap);
+ *	SLIST_HEAP_INSERT(T, heap, node)		// O(1)
+ *	SLIST_HEAP_MELD(T, heap, other)			// moves all of other into heap, O(1)
+ *	SLIST_HEAP_PEEK(heap)					// heap node<T>* with the minimum, or NULL
+ *	SLIST_HEAP_POP_MIN(T, heap)				// same, removing it, amortized O(log N)
+ *	SLIST_HEAP_COUNT(heap)
+ *	SLIST_HEAP_IS_EMPTY(heap)
+ */
+
+#define SLIST_HEAP_NODE(T) \
+struct sSLIST_##T##_HeapNode
+
+#define SLIST_HEAP(T) \
+struct sSLIST_##T##_Heap
+
+#define SLIST_CREATE_HEAP(T, heap_) \
+SLIST_HEAP(T) heap_ = { NULL, 0 }
+
+#define SLIST_HEAP_INSERT(T, heap_, node_) \
+SLIST_heap_insert_##T(&(heap_), &(node_))
+
+#define SLIST_HEAP_INSERT_PTR(T, heap_, node_) \
+SLIST_heap_insert_##T(&(heap_), (node_))
+
+#define SLIST_HEAP_MELD(T, heap_, other_) \
+SLIST_heap_meld_##T(&(heap_), &(other_))
+
+#define SLIST_HEAP_PEEK(heap_) \
+((heap_).root)
+
+#define SLIST_HEAP_POP_MIN(T, heap_) \
+SLIST_heap_pop_min_##T(&(heap_))
+
+#define SLIST_HEAP_COUNT(heap_) \
+((heap_).count)
+
+#define SLIST_HEAP_IS_EMPTY(heap_) \
+((heap_).root == NULL)
+
+/*
+ * The templates themselves
+ *
+ * The sibling link is the `next` of the embedded list node, the list node
+ * being the first member a pointer to it is also a pointer to the heap node.
+ */
+
+#define SLIST_HEAP_SIBLING(T, node_) \
+((SLIST_HEAP_NODE(T)*)(node_)->link.next)
+
+#define SLIST_HEAP_DECLARE_WITH_STORAGE(T, storage_) \
+SLIST_HEAP_NODE(T) { \
+    SLIST_NODE(T) link; \
+    SLIST_HEAP_NODE(T)* child; \
+}; \
+SLIST_HEAP(T) { \
+    SLIST_HEAP_NODE(T)* root; \
+    size_t count; \
+}; \
+storage_ void SLIST_heap_insert_##T(SLIST_HEAP(T)* heap, SLIST_HEAP_NODE(T)* node); \
+storage_ SLIST_MAYBE_UNUSED void SLIST_heap_meld_##T(SLIST_HEAP(T)* heap, SLIST_HEAP(T)* other); \
+storage_ SLIST_HEAP_NODE(T)* SLIST_heap_pop_min_##T(SLIST_HEAP(T)* heap)
+
+#define SLIST_HEAP_DEFINE_WITH_STORAGE(T, LESS, storage_) \
+static SLIST_HEAP_NODE(T)* SLIST_heap_link_##T(SLIST_HEAP_NODE(T)* a, SLIST_HEAP_NODE(T)* b) \
+{ \
+    if (a == NULL) \
+    { \
+        return b; \
+    } \
+    if (b == NULL) \
+    { \
+        return a; \
+    } \
+    if (LESS(&b->link.data, &a->link.data)) \
+    { \
+        SLIST_HEAP_NODE(T)* tmp = a; \
+        a = b; \
+        b = tmp; \
+    } \
+    b->link.next = (SLIST_NODE(T)*)a->child; \
+    a->child = b; \
+    return a; \
+} \
+\
+storage_ void SLIST_heap_insert_##T(SLIST_HEAP(T)* heap, SLIST_HEAP_NODE(T)* node) \
+{ \
+    node->link.next = NULL; \
+    node->child = NULL; \
+    heap->root = SLIST_heap_link_##T(heap->root, node); \
+    heap->count++; \
+} \
+\
+storage_ void SLIST_heap_meld_##T(SLIST_HEAP(T)* heap, SLIST_HEAP(T)* other) \
+{ \
+    heap->root = SLIST_heap_link_##T(heap->root, other->root); \
+    heap->count += other->count; \
+    other->root = NULL; \
+    other->count = 0; \
+} \
+\
+storage_ SLIST_HEAP_NODE(T)* SLIST_heap_pop_min_##T(SLIST_HEAP(T)* heap) \
+{ \
+    SLIST_HEAP_NODE(T)* min = heap->root; \
+    SLIST_HEAP_NODE(T)* pairs = NULL; \
+    SLIST_HEAP_NODE(T)* first; \
+    if (min == NULL) \
+    { \
+        return NULL; \
+    } \
+    /* First pass: link children by pairs left to right, stacking the results */ \
+    first = min->child; \
+    while (first != NULL) \
+    { \
+        SLIST_HEAP_NODE(T)* a = first; \
+        SLIST_HEAP_NODE(T)* b = SLIST_HEAP_SIBLING(T, a); \
+        first = (b != NULL) ? SLIST_HEAP_SIBLING(T, b) : NULL; \
+        a->link.next = NULL; \
+        if (b != NULL) \
+        { \
+            b->link.next = NULL; \
+        } \
+        a = SLIST_heap_link_##T(a, b); \
+        a->link.next = (SLIST_NODE(T)*)pairs; \
+        pairs = a; \
+    } \
+    /* Second pass: link the stacked pairs right to left */ \
+    heap->root = NULL; \
+    while (pairs != NULL) \
+    { \
+        SLIST_HEAP_NODE(T)* next = SLIST_HEAP_SIBLING(T, pairs); \
+        pairs->link.next = NULL; \
+        heap->root = SLIST_heap_link_##T(heap->root, pairs); \
+        pairs = next; \
+    } \
+    heap->count--; \
+    min->child = NULL; \
+    min->link.next = NULL; \
+    return min; \
+}
+
+#endif /* SLIST_HEAP_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
@@ -0,0 +1,335 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_pool_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Node pool with generation counted handles for the single list template
+ *
+ * @details
+ *
+ *	A pool is a fixed array of SLIST_NODE(T) handed out and recycled by the
+ *	pool itself. Nodes are referred to through handles, an index in the pool
+ *	plus the generation of the slot when it was allocated. Every time a slot
+ *	is released its generation changes, so a handle kept after its node has
+ *	been recycled is detected as stale in O(1), without searching any list.
+ *
+ *	The pool has to be instantiated like the list itself, after it:
+ *
+ *		```
+ *		uint32_slist_implementation.h:
+ *			SLIST_DECLARE(uint32_t)
+ *			SLIST_POOL_DECLARE(uint32_t)
+ *
+ *		uint32_slist_implementation.c:
+ *			SLIST_DEFINE(uint32_t)
+ *			SLIST_POOL_DEFINE(uint32_t)
+ *		```
+ *
+ *	Usage:
+ *
+ *		SLIST_CREATE_POOL(uint32_t, pool, 32);
+ *		SLIST_CREATE_LIST(uint32_t, list);
+ *
+ *		SLIST_HANDLE(uint32_t) h = SLIST_POOL_ALLOC(uint32_t, pool);
+ *		SLIST_POOL_LOOKUP(uint32_t, pool, h)->data = 7;
+ *		SLIST_POOL_ADD(uint32_t, pool, list, h);
+ *		...
+ *		SLIST_POOL_REMOVE(uint32_t, pool, list, h);		// O(1), h becomes stale
+ *		SLIST_POOL_IS_VALID(uint32_t, pool, h);			// 0
+ *
+ *	To make the removal O(1) the pool remembers the predecessor of every
+ *	linked node, so lists holding pool nodes have to be modified only through
+ *	SLIST_POOL_ADD and SLIST_POOL_REMOVE, and hold nodes of a single pool.
+ *	Traversing them with SLIST_FOR_EACH_NODE_PTR is fine.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_POOL_TEMPLATE_H_
+#define SLIST_POOL_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+#include <stdint.h>
+
+/*****************************************************************************
+ * CONFIGURATION
+ ****************************************************************************/
+
+/*
+ * Misuse that cannot be reported through the result, like a node outside of
+ * the pool given to SLIST_POOL_HANDLE_OF, goes to the SLIST_ASSERT hook in
+ * validation builds (SLIST_ENABLE_VALIDATION), and is ignored otherwise.
+ */
+#ifdef SLIST_ENABLE_VALIDATION
+#define SLIST_POOL_ASSERT(expr_, msg_) SLIST_ASSERT(expr_, msg_)
+#else
+#define SLIST_POOL_ASSERT(expr_, msg_) ((void)0)
+#endif
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use either:
+ *
+ * - SLIST_POOL_DECLARE(T) in a C header: for public declaration
+ * - SLIST_POOL_DECLARE_STATIC(T) in a C module: for private declaration
+ */
+
+#define SLIST_POOL_DECLARE(T) \
+SLIST_POOL_DECLARE_WITH_STORAGE(T, extern)
+
+#define SLIST_POOL_DECLARE_STATIC(T) \
+SLIST_POOL_DECLARE_WITH_STORAGE(T, static)
+
+/*
+ * Use either:
+ *
+ * - SLIST_POOL_DEFINE(T) in a C module: for public definition
+ * - SLIST_POOL_DEFINE_STATIC(T) in a C module: for private definition
+ */
+
+#define SLIST_POOL_DEFINE(T) \
+SLIST_POOL_DEFINE_WITH_STORAGE(T, )
+
+#define SLIST_POOL_DEFINE_STATIC(T) \
+SLIST_POOL_DEFINE_WITH_STORAGE(T, static)
+
+/*
+ * Usage:
+ *
+ *	SLIST_CREATE_POOL(T, pool, N);			// creates a pool of N node<T>
+ *	SLIST_CREATE_POOL_STATIC(T, pool, N);	// same, with static storage
+ *	SLIST_POOL_ALLOC(T, pool)				// handle<T>, invalid if exhausted
+ *	SLIST_POOL_FREE(T, pool, handle)		// releases an unlinked node
+ *	SLIST_POOL_IS_VALID(T, pool, handle)	// handle still refers to its node
+ *	SLIST_POOL_LOOKUP(T, pool, handle)		// node<T>*, NULL if stale
+ *	SLIST_POOL_HANDLE_OF(T, pool, node)		// handle<T> of an allocated node, invalid if free or not in the pool
+ *	SLIST_POOL_ADD(T, pool, list, handle)	// appends without repetition
+ *	SLIST_POOL_REMOVE(T, pool, list, handle)	// unlinks and releases, O(1)
+ *
+ * All of them are O(1) but SLIST_POOL_ADD, which walks to the tail as
+ * SLIST_ADD_NODE does. N is checked at compile time.
+ */
+
+#define SLIST_POOL(T) \
+struct sSLIST_##T##_Pool
+
+#define SLIST_HANDLE(T) \
+struct sSLIST_##T##_Handle
+
+#define SLIST_CREATE_POOL(T, pool_, capacity_) \
+SLIST_CREATE_POOL_WITH_STORAGE(T, pool_, capacity_, )
+
+#define SLIST_CREATE_POOL_STATIC(T, pool_, capacity_) \
+SLIST_CREATE_POOL_WITH_STORAGE(T, pool_, capacity_, static)
+
+#define SLIST_POOL_ALLOC(T, pool_) \
+SLIST_pool_alloc_##T(&(pool_))
+
+#define SLIST_POOL_FREE(T, pool_, handle_) \
+SLIST_pool_free_##T(&(pool_), (handle_))
+
+#define SLIST_POOL_IS_VALID(T, pool_, handle_) \
+(SLIST_pool_lookup_##T(&(pool_), (handle_)) != NULL)
+
+#define SLIST_POOL_LOOKUP(T, pool_, handle_) \
+SLIST_pool_lookup_##T(&(pool_), (handle_))
+
+#define SLIST_POOL_HANDLE_OF(T, pool_, node_) \
+SLIST_pool_handle_of_##T(&(pool_), (node_))
+
+#define SLIST_POOL_ADD(T, pool_, head_, handle_) \
+SLIST_pool_add_##T(&(pool_), &(head_), (handle_))
+
+#define SLIST_POOL_REMOVE(T, pool_, head_, handle_) \
+SLIST_pool_remove_##T(&(pool_), &(head_), (handle_))
+
+/*
+ * Slot bookkeeping
+ *
+ * The generation of a slot is odd while allocated and even while free, so
+ * handles (always taken while allocated) never match a free slot, and an even
+ * generation is never valid. link holds
+ * the next free slot while free, and while allocated the predecessor of the
+ * node in its list, SLIST_POOL_AT_HEAD, or SLIST_POOL_NONE when not linked.
+ */
+
+#define SLIST_POOL_NONE ((uint32_t)0xFFFFFFFFu)
+#define SLIST_POOL_AT_HEAD ((uint32_t)0xFFFFFFFEu)
+
+struct sSLIST_PoolSlot {
+    uint32_t generation;
+    uint32_t link;
+};
+
+/*
+ * The templates themselves
+ */
+
+#define SLIST_CREATE_POOL_WITH_STORAGE(T, pool_, capacity_, storage_) \
+SLIST_STATIC_ASSERT((capacity_) > 0 && (capacity_) < SLIST_POOL_AT_HEAD, pool_##CapacityIsValid); \
+storage_ SLIST_NODE(T) pool_##Nodes[capacity_]; \
+storage_ struct sSLIST_PoolSlot pool_##Slots[capacity_]; \
+storage_ SLIST_POOL(T) pool_ = { pool_##Nodes, pool_##Slots, (capacity_), 0, SLIST_POOL_NONE }
+
+#define SLIST_POOL_DECLARE_WITH_STORAGE(T, storage_) \
+SLIST_POOL(T) { \
+    SLIST_NODE(T)* nodes; \
+    struct sSLIST_PoolSlot* slots; \
+    uint32_t capacity; \
+    uint32_t used; \
+    uint32_t freeList; \
+}; \
+SLIST_HANDLE(T) { \
+    uint32_t index; \
+    uint32_t generation; \
+}; \
+storage_ SLIST_MAYBE_UNUSED SLIST_HANDLE(T) SLIST_pool_alloc_##T(SLIST_POOL(T)* pool); \
+storage_ SLIST_MAYBE_UNUSED int SLIST_pool_free_##T(SLIST_POOL(T)* pool, SLIST_HANDLE(T) handle); \
+storage_ SLIST_MAYBE_UNUSED SLIST_NODE(T)* SLIST_pool_lookup_##T(const SLIST_POOL(T)* pool, SLIST_HANDLE(T) handle); \
+storage_ SLIST_MAYBE_UNUSED SLIST_HANDLE(T) SLIST_pool_handle_of_##T(const SLIST_POOL(T)* pool, const SLIST_NODE(T)* node); \
+storage_ SLIST_MAYBE_UNUSED int SLIST_pool_add_##T(SLIST_POOL(T)* pool, SLIST_NODE(T)** head, SLIST_HANDLE(T) handle); \
+storage_ SLIST_MAYBE_UNUSED int SLIST_pool_remove_##T(SLIST_POOL(T)* pool, SLIST_NODE(T)** head, SLIST_HANDLE(T) handle)
+
+#define SLIST_POOL_DEFINE_WITH_STORAGE(T, storage_) \
+storage_ SLIST_HANDLE(T) SLIST_pool_alloc_##T(SLIST_POOL(T)* pool) \
+{ \
+    SLIST_HANDLE(T) handle = { 0, 0 }; \
+    uint32_t index; \
+    if (pool->freeList != SLIST_POOL_NONE) \
+    { \
+        index = pool->freeList; \
+        pool->freeList = pool->slots[index].link; \
+    } \
+    else if (pool->used < pool->capacity) \
+    { \
+        index = pool->used++; \
+        pool->slots[index].generation = 0; \
+    } \
+    else \
+    { \
+        return handle; \
+    } \
+    pool->slots[index].generation++; \
+    pool->slots[index].link = SLIST_POOL_NONE; \
+    handle.index = index; \
+    handle.generation = pool->slots[index].generation; \
+    return handle; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_pool_lookup_##T(const SLIST_POOL(T)* pool, SLIST_HANDLE(T) handle) \
+{ \
+    if (handle.index >= pool->used || (handle.generation & 1u) == 0 || \
+        pool->slots[handle.index].generation != handle.generation) \
+    { \
+        return NULL; \
+    } \
+    return &pool->nodes[handle.index]; \
+} \
+\
+storage_ SLIST_HANDLE(T) SLIST_pool_handle_of_##T(const SLIST_POOL(T)* pool, const SLIST_NODE(T)* node) \
+{ \
+    SLIST_HANDLE(T) handle = { 0, 0 }; \
+    int inPool = node >= pool->nodes && node < pool->nodes + pool->used; \
+    SLIST_POOL_ASSERT(inPool, "slist<" #T "> node is not in the pool"); \
+    if (!inPool) \
+    { \
+        return handle; \
+    } \
+    handle.index = (uint32_t)(node - pool->nodes); \
+    if ((pool->slots[handle.index].generation & 1u) != 0) \
+    { \
+        handle.generation = pool->slots[handle.index].generation; \
+    } \
+    return handle; \
+} \
+\
+storage_ int SLIST_pool_free_##T(SLIST_POOL(T)* pool, SLIST_HANDLE(T) handle) \
+{ \
+    if (SLIST_pool_lookup_##T(pool, handle) == NULL || \
+        pool->slots[handle.index].link != SLIST_POOL_NONE) \
+    { \
+        return 0; \
+    } \
+    pool->slots[handle.index].generation++; \
+    pool->slots[handle.index].link = pool->freeList; \
+    pool->freeList = handle.index; \
+    return 1; \
+} \
+\
+storage_ int SLIST_pool_add_##T(SLIST_POOL(T)* pool, SLIST_NODE(T)** head, SLIST_HANDLE(T) handle) \
+{ \
+    SLIST_NODE(T)* node = SLIST_pool_lookup_##T(pool, handle); \
+    if (node == NULL || pool->slots[handle.index].link != SLIST_POOL_NONE) \
+    { \
+        return 0; \
+    } \
+    if (*head == NULL) \
+    { \
+        *head = node; \
+        pool->slots[handle.index].link = SLIST_POOL_AT_HEAD; \
+    } \
+    else \
+    { \
+        SLIST_NODE(T)* tail = *head; \
+        while (tail->next != NULL) \
+        { \
+            tail = tail->next; \
+        } \
+        tail->next = node; \
+        pool->slots[handle.index].link = (uint32_t)(tail - pool->nodes); \
+    } \
+    node->next = NULL; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return 1; \
+} \
+\
+storage_ int SLIST_pool_remove_##T(SLIST_POOL(T)* pool, SLIST_NODE(T)** head, SLIST_HANDLE(T) handle) \
+{ \
+    SLIST_NODE(T)* node = SLIST_pool_lookup_##T(pool, handle); \
+    if (node == NULL || pool->slots[handle.index].link == SLIST_POOL_NONE) \
+    { \
+        return 0; \
+    } \
+    uint32_t prev = pool->slots[handle.index].link; \
+    if (prev == SLIST_POOL_AT_HEAD) \
+    { \
+        if (*head != node) \
+        { \
+            return 0; \
+        } \
+        *head = node->next; \
+    } \
+    else \
+    { \
+        pool->nodes[prev].next = node->next; \
+    } \
+    if (node->next != NULL) \
+    { \
+        pool->slots[node->next - pool->nodes].link = prev; \
+    } \
+    node->next = NULL; \
+    pool->slots[handle.index].link = SLIST_POOL_NONE; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return SLIST_pool_free_##T(pool, handle); \
+}
+
+#endif /* SLIST_POOL_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
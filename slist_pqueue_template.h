@@ -0,0 +1,218 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_pqueue_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Bucketed priority queue over the single list template
+ *
+ * @details
+ *
+ *	For a small fixed number of priority levels (up to 64) the queue keeps a
+ *	FIFO list per level plus a bitmap of the levels that are not empty. The
+ *	highest non empty level is found with a single count leading zeros, so
+ *	both push and pop are O(1), and nodes of the same priority come out in
+ *	the order they were pushed.
+ *
+ *	The queue is instantiated per type and number of levels, after the list:
+ *
+ *		```
+ *		SLIST_DECLARE(uint32_t)
+ *		SLIST_PQUEUE_DECLARE(uint32_t, 8)
+ *		...
+ *		SLIST_DEFINE(uint32_t)
+ *		SLIST_PQUEUE_DEFINE(uint32_t, 8)
+ *		```
+ *
+ *	LEVELS is pasted into the generated names, so it has to be a plain integer
+ *	literal or a macro expanding to one.
+ *
+ *	Usage:
+ *
+ *		SLIST_CREATE_PQUEUE(uint32_t, 8, queue);
+ *		SLIST_PQUEUE_PUSH(uint32_t, 8, queue, node, 5);	// 0 is the lowest priority
+ *		SLIST_NODE(uint32_t)* next = SLIST_PQUEUE_POP(uint32_t, 8, queue);
+ *
+ *	Pushing does not check for repetition, the node must not be on any list.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_PQUEUE_TEMPLATE_H_
+#define SLIST_PQUEUE_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+#include <stdint.h>
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use either:
+ *
+ * - SLIST_PQUEUE_DECLARE(T, LEVELS) in a C header: for public declaration
+ * - SLIST_PQUEUE_DECLARE_STATIC(T, LEVELS) in a C module: for private declaration
+ */
+
+#define SLIST_PQUEUE_DECLARE(T, LEVELS) \
+SLIST_PQUEUE_DECLARE_WITH_STORAGE(T, LEVELS, extern)
+
+#define SLIST_PQUEUE_DECLARE_STATIC(T, LEVELS) \
+SLIST_PQUEUE_DECLARE_WITH_STORAGE(T, LEVELS, static)
+
+/*
+ * Use either:
+ *
+ * - SLIST_PQUEUE_DEFINE(T, LEVELS) in a C module: for public definition
+ * - SLIST_PQUEUE_DEFINE_STATIC(T, LEVELS) in a C module: for private definition
+ */
+
+#define SLIST_PQUEUE_DEFINE(T, LEVELS) \
+SLIST_PQUEUE_DEFINE_WITH_STORAGE(T, LEVELS, )
+
+#define SLIST_PQUEUE_DEFINE_STATIC(T, LEVELS) \
+SLIST_PQUEUE_DEFINE_WITH_STORAGE(T, LEVELS, static)
+
+/*
+ * Usage:
+ *
+ *	SLIST_CREATE_PQUEUE(T, LEVELS, queue);
+ *	SLIST_PQUEUE_PUSH(T, LEVELS, queue, node, priority)	// 0 if priority >= LEVELS
+ *	SLIST_PQUEUE_POP(T, LEVELS, queue)			// node<T>* of highest priority, or NULL
+ *	SLIST_PQUEUE_PEEK(T, LEVELS, queue)			// same, without removing it
+ *	SLIST_PQUEUE_TOP_PRIORITY(queue)			// highest non empty level, -1 if empty
+ *	SLIST_PQUEUE_COUNT(queue)
+ *	SLIST_PQUEUE_IS_EMPTY(queue)
+ */
+
+#define SLIST_PQUEUE(T, LEVELS) \
+SLIST_PQUEUE_TYPE(T, LEVELS)
+
+#define SLIST_CREATE_PQUEUE(T, LEVELS, queue_) \
+SLIST_PQUEUE(T, LEVELS) queue_ = { 0, 0, { NULL }, { NULL } }
+
+#define SLIST_PQUEUE_PUSH(T, LEVELS, queue_, node_, priority_) \
+SLIST_PQUEUE_FUNC(push, T, LEVELS)(&(queue_), &(node_), (priority_))
+
+#define SLIST_PQUEUE_PUSH_PTR(T, LEVELS, queue_, node_, priority_) \
+SLIST_PQUEUE_FUNC(push, T, LEVELS)(&(queue_), (node_), (priority_))
+
+#define SLIST_PQUEUE_POP(T, LEVELS, queue_) \
+SLIST_PQUEUE_FUNC(pop, T, LEVELS)(&(queue_))
+
+#define SLIST_PQUEUE_PEEK(T, LEVELS, queue_) \
+(SLIST_PQUEUE_IS_EMPTY(queue_) ? NULL : (queue_).head[SLIST_PQUEUE_TOP_PRIORITY(queue_)])
+
+#define SLIST_PQUEUE_TOP_PRIORITY(queue_) \
+SLIST_highest_bit((queue_).nonEmpty)
+
+#define SLIST_PQUEUE_COUNT(queue_) \
+((queue_).count)
+
+#define SLIST_PQUEUE_IS_EMPTY(queue_) \
+((queue_).nonEmpty == 0)
+
+/*
+ * Index of the most significant bit set, -1 for 0
+ */
+
+static inline int SLIST_highest_bit(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (bits == 0) ? -1 : 63 - __builtin_clzll(bits);
+#else
+    int bit = -1;
+    while (bits != 0)
+    {
+        bits >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/*
+ * The templates themselves
+ */
+
+/* Extra level so that LEVELS gets expanded before being pasted */
+#define SLIST_PQUEUE_TYPE(T, LEVELS) \
+struct sSLIST_##T##_PQueue_##LEVELS
+
+#define SLIST_PQUEUE_FUNC(name_, T, LEVELS) \
+SLIST_PQUEUE_FUNC_NAME(name_, T, LEVELS)
+
+#define SLIST_PQUEUE_FUNC_NAME(name_, T, LEVELS) \
+SLIST_pqueue_##name_##_##T##_##LEVELS
+
+#define SLIST_PQUEUE_DECLARE_WITH_STORAGE(T, LEVELS, storage_) \
+SLIST_STATIC_ASSERT((LEVELS) > 0 && (LEVELS) <= 64, sSLIST_##T##_PQueue_##LEVELS##_FitsBitmap); \
+SLIST_PQUEUE(T, LEVELS) { \
+    uint64_t nonEmpty; \
+    size_t count; \
+    SLIST_NODE(T)* head[LEVELS]; \
+    SLIST_NODE(T)* tail[LEVELS]; \
+}; \
+storage_ int SLIST_PQUEUE_FUNC(push, T, LEVELS)(SLIST_PQUEUE(T, LEVELS)* queue, SLIST_NODE(T)* node, unsigned priority); \
+storage_ SLIST_NODE(T)* SLIST_PQUEUE_FUNC(pop, T, LEVELS)(SLIST_PQUEUE(T, LEVELS)* queue)
+
+#define SLIST_PQUEUE_DEFINE_WITH_STORAGE(T, LEVELS, storage_) \
+storage_ int SLIST_PQUEUE_FUNC(push, T, LEVELS)(SLIST_PQUEUE(T, LEVELS)* queue, SLIST_NODE(T)* node, unsigned priority) \
+{ \
+    if (priority >= (LEVELS)) \
+    { \
+        return 0; \
+    } \
+    node->next = NULL; \
+    if (queue->head[priority] == NULL) \
+    { \
+        queue->head[priority] = node; \
+        queue->nonEmpty |= (uint64_t)1 << priority; \
+    } \
+    else \
+    { \
+        queue->tail[priority]->next = node; \
+    } \
+    queue->tail[priority] = node; \
+    queue->count++; \
+    SLIST_VALIDATE_LIST(T, queue->head[priority]); \
+    return 1; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_PQUEUE_FUNC(pop, T, LEVELS)(SLIST_PQUEUE(T, LEVELS)* queue) \
+{ \
+    int priority = SLIST_highest_bit(queue->nonEmpty); \
+    if (priority < 0) \
+    { \
+        return NULL; \
+    } \
+    SLIST_NODE(T)* node = queue->head[priority]; \
+    queue->head[priority] = node->next; \
+    if (node->next == NULL) \
+    { \
+        queue->tail[priority] = NULL; \
+        queue->nonEmpty &= ~((uint64_t)1 << priority); \
+    } \
+    node->next = NULL; \
+    queue->count--; \
+    SLIST_VALIDATE_LIST(T, queue->head[priority]); \
+    return node; \
+}
+
+#endif /* SLIST_PQUEUE_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
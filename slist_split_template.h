@@ -0,0 +1,164 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_split_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Hot/cold split nodes for lists of large records
+ *
+ * @details
+ *
+ *	With a large T every step of a walk drags the whole record through the
+ *	cache just to reach `next`. A split list keeps inline only what walks
+ *	need, a small key and the link, while the rest of the record (the cold
+ *	part) lives elsewhere and is reached through a pointer:
+ *
+ *		SLIST_NODE(T) { T data { K key; C* cold; }; SLIST_NODE(T)* next; }
+ *
+ *	so searching or iterating over keys touches a single cache line per node
+ *	(checked at compile time). The cold parts may be allocated anywhere, a
+ *	parallel array indexed like the node array being the usual choice.
+ *
+ *	The split list is a regular list<T> whose T is generated from the key and
+ *	cold types, so every list macro (add, pop, cursors, for each...) applies.
+ *	It is instantiated instead of the list, the definition taking a function
+ *	or macro EQ(const K* a, const K* b) returning non zero for equal keys:
+ *
+ *		```
+ *		SLIST_SPLIT_DECLARE(sSession, uint32_t, sSessionRecord)
+ *		...
+ *		#define SESSION_EQ(a, b) (*(a) == *(b))
+ *		SLIST_SPLIT_DEFINE(sSession, SESSION_EQ)
+ *		```
+ *
+ *	Usage:
+ *
+ *		SLIST_CREATE_LIST(sSession, sessions);
+ *		SLIST_SPLIT_BIND(node, id, &records[i]);
+ *		SLIST_ADD_NODE(sSession, sessions, node);
+ *		SLIST_NODE(sSession)* found = SLIST_SPLIT_FIND(sSession, sessions, id);
+ *		if (found != NULL) { use(SLIST_SPLIT_COLD(found)); }
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_SPLIT_TEMPLATE_H_
+#define SLIST_SPLIT_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+
+/*****************************************************************************
+ * CONFIGURATION
+ ****************************************************************************/
+
+/*
+ * Size a split node must fit in, the cache line of the target
+ */
+#ifndef SLIST_SPLIT_HOT_SIZE
+#define SLIST_SPLIT_HOT_SIZE 64u
+#endif
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use either:
+ *
+ * - SLIST_SPLIT_DECLARE(T, K, C) in a C header: for public declaration
+ * - SLIST_SPLIT_DECLARE_STATIC(T, K, C) in a C module: for private declaration
+ */
+
+#define SLIST_SPLIT_DECLARE(T, K, C) \
+SLIST_SPLIT_DECLARE_WITH_STORAGE(T, K, C, extern)
+
+#define SLIST_SPLIT_DECLARE_STATIC(T, K, C) \
+SLIST_SPLIT_DECLARE_WITH_STORAGE(T, K, C, static)
+
+/*
+ * Use either:
+ *
+ * - SLIST_SPLIT_DEFINE(T, EQ) in a C module: for public definition
+ * - SLIST_SPLIT_DEFINE_STATIC(T, EQ) in a C module: for private definition
+ */
+
+#define SLIST_SPLIT_DEFINE(T, EQ) \
+SLIST_SPLIT_DEFINE_WITH_STORAGE(T, EQ, )
+
+#define SLIST_SPLIT_DEFINE_STATIC(T, EQ) \
+SLIST_SPLIT_DEFINE_WITH_STORAGE(T, EQ, static)
+
+/*
+ * Usage:
+ *
+ *	SLIST_SPLIT_BIND(node, key, cold)		// sets the key and cold pointer of node<T>
+ *	SLIST_SPLIT_KEY(nodePtr)				// key of node<T>*
+ *	SLIST_SPLIT_COLD(nodePtr)				// cold part of node<T>*
+ *	SLIST_SPLIT_FIND(T, list, key)			// first node<T>* with key, or NULL
+ */
+
+#define SLIST_SPLIT_KEY_TYPE(T) \
+sSLIST_##T##_Key
+
+#define SLIST_SPLIT_BIND(node_, key_, cold_) \
+do { (node_).data.key = (key_); (node_).data.cold = (cold_); } while (0)
+
+#define SLIST_SPLIT_KEY(node_) \
+((node_)->data.key)
+
+#define SLIST_SPLIT_COLD(node_) \
+((node_)->data.cold)
+
+#define SLIST_SPLIT_FIND(T, head_, key_) \
+SLIST_split_find_##T((head_), (key_))
+
+/*
+ * The templates themselves
+ *
+ * The key is passed by value so that SLIST_SPLIT_FIND takes literals, EQ
+ * getting a pointer to the parameter.
+ */
+
+#define SLIST_SPLIT_DECLARE_WITH_STORAGE(T, K, C, storage_) \
+typedef K SLIST_SPLIT_KEY_TYPE(T); \
+typedef struct { \
+    K key; \
+    C* cold; \
+} T; \
+SLIST_DECLARE_WITH_STORAGE(T, storage_); \
+SLIST_STATIC_ASSERT(sizeof(SLIST_NODE(T)) <= SLIST_SPLIT_HOT_SIZE, sSLIST_##T##_HotFitsLine); \
+storage_ SLIST_NODE(T)* SLIST_split_find_##T(SLIST_NODE(T)* head, SLIST_SPLIT_KEY_TYPE(T) key)
+
+#define SLIST_SPLIT_DEFINE_WITH_STORAGE(T, EQ, storage_) \
+SLIST_DEFINE_WITH_STORAGE(T, storage_) \
+\
+storage_ SLIST_NODE(T)* SLIST_split_find_##T(SLIST_NODE(T)* head, SLIST_SPLIT_KEY_TYPE(T) key) \
+{ \
+    SLIST_NODE(T)* node; \
+    SLIST_VALIDATE_LIST(T, head); \
+    for (node = head; node != NULL; node = node->next) \
+    { \
+        if (EQ(&node->data.key, &key)) \
+        { \
+            break; \
+        } \
+    } \
+    return node; \
+}
+
+#endif /* SLIST_SPLIT_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
@@ -0,0 +1,225 @@
+/*************************************************************************//**
+ * @copyright COPYRIGHT (C) 2021 IDNEO S.A.U.
+ *
+ * @file slist_spsc_template.h
+ * @date 2021-03-11
+ * @author Carles Marsal
+ *
+ * Language C99 (GCC or Clang atomic builtins)
+ *
+ * @version $Id$
+ *
+ * @addtogroup Collections
+ * @{
+ *
+ * @brief Wait-free single producer single consumer queue over list nodes
+ *
+ * @details
+ *
+ *	A FIFO queue between exactly one producer thread and one consumer thread,
+ *	linking the client nodes themselves (no copies, no memory). It keeps a
+ *	stub node so that producer and consumer never write the same pointer:
+ *
+ *	- push: a relaxed store, an atomic exchange of the tail and a release
+ *	  store of the link
+ *	- pop: acquire loads and plain stores, plus the push of the stub when
+ *	  the last node of the queue is taken, so that it can be handed out
+ *
+ *	Neither side loops nor uses compare and swap, so both are wait-free. The
+ *	producer state (tail) and the consumer state (head) live on different
+ *	cache lines (SLIST_CACHE_LINE), not to slow each other down.
+ *
+ *	The queue is instantiated per type after the list:
+ *
+ *		```
+ *		SLIST_DECLARE(sPacket)
+ *		SLIST_SPSC_DECLARE(sPacket)
+ *		...
+ *		SLIST_DEFINE(sPacket)
+ *		SLIST_SPSC_DEFINE(sPacket)
+ *		```
+ *
+ *	Usage:
+ *
+ *		static SLIST_SPSC(sPacket) queue;
+ *		SLIST_SPSC_INIT(sPacket, queue);			// before both threads start
+ *
+ *		producer: SLIST_SPSC_PUSH(sPacket, queue, node);
+ *		consumer: SLIST_NODE(sPacket)* next = SLIST_SPSC_POP(sPacket, queue);	// NULL if empty
+ *
+ *	A pushed node belongs to the queue until it is popped, and may be pushed
+ *	again right after. Pop may return NULL while a push is completing, the
+ *	node showing up on the next pop. The queue must not be moved once
+ *	initialized (it points to its own stub), and its nodes must not use the
+ *	packed layout, whose links cannot be accessed atomically.
+ *
+ ****************************************************************************/
+
+#ifndef SLIST_SPSC_TEMPLATE_H_
+#define SLIST_SPSC_TEMPLATE_H_
+
+/*****************************************************************************
+ * INCLUDES
+ ****************************************************************************/
+#include "slist_template.h"
+
+/*****************************************************************************
+ * CONFIGURATION
+ ****************************************************************************/
+
+#if !defined(__GNUC__)
+#error "slist_spsc_template.h needs the GCC/Clang __atomic builtins"
+#endif
+
+#define SLIST_SPSC_LOAD_ACQUIRE(pointer_) \
+__atomic_load_n((pointer_), __ATOMIC_ACQUIRE)
+
+#define SLIST_SPSC_STORE_RELAXED(pointer_, value_) \
+__atomic_store_n((pointer_), (value_), __ATOMIC_RELAXED)
+
+#define SLIST_SPSC_STORE_RELEASE(pointer_, value_) \
+__atomic_store_n((pointer_), (value_), __ATOMIC_RELEASE)
+
+#define SLIST_SPSC_EXCHANGE(pointer_, value_) \
+__atomic_exchange_n((pointer_), (value_), __ATOMIC_ACQ_REL)
+
+/*
+ * Hook run between the steps of push and pop, for stress tests to inject
+ * yields where the other thread may interleave. Nothing by default.
+ */
+#ifndef SLIST_SPSC_YIELD
+#define SLIST_SPSC_YIELD() ((void)0)
+#endif
+
+/*****************************************************************************
+ * MACROS
+ ****************************************************************************/
+
+/*
+ * Use either:
+ *
+ * - SLIST_SPSC_DECLARE(T) in a C header: for public declaration
+ * - SLIST_SPSC_DECLARE_STATIC(T) in a C module: for private declaration
+ */
+
+#define SLIST_SPSC_DECLARE(T) \
+SLIST_SPSC_DECLARE_WITH_STORAGE(T, extern)
+
+#define SLIST_SPSC_DECLARE_STATIC(T) \
+SLIST_SPSC_DECLARE_WITH_STORAGE(T, static)
+
+/*
+ * Use either:
+ *
+ * - SLIST_SPSC_DEFINE(T) in a C module: for public definition
+ * - SLIST_SPSC_DEFINE_STATIC(T) in a C module: for private definition
+ */
+
+#define SLIST_SPSC_DEFINE(T) \
+SLIST_SPSC_DEFINE_WITH_STORAGE(T, )
+
+#define SLIST_SPSC_DEFINE_STATIC(T) \
+SLIST_SPSC_DEFINE_WITH_STORAGE(T, static)
+
+/*
+ * Usage:
+ *
+ *	SLIST_SPSC_INIT(T, queue)				// empty, not thread safe
+ *	SLIST_SPSC_PUSH(T, queue, node)			// producer thread only
+ *	SLIST_SPSC_POP(T, queue)				// consumer thread only, node<T>* or NULL
+ */
+
+#define SLIST_SPSC(T) \
+struct sSLIST_##T##_Spsc
+
+#define SLIST_SPSC_INIT(T, queue_) \
+SLIST_spsc_init_##T(&(queue_))
+
+#define SLIST_SPSC_PUSH(T, queue_, node_) \
+SLIST_spsc_push_##T(&(queue_), &(node_))
+
+#define SLIST_SPSC_PUSH_PTR(T, queue_, node_) \
+SLIST_spsc_push_##T(&(queue_), (node_))
+
+#define SLIST_SPSC_POP(T, queue_) \
+SLIST_spsc_pop_##T(&(queue_))
+
+/*
+ * The templates themselves
+ *
+ * head is the oldest node still linked, the stub or the last node popped
+ * never being handed out while it is the tail, since the producer is about
+ * to write its link. When the consumer reaches the tail it pushes the stub
+ * behind it to release it: that is the only write of the consumer to the
+ * producer side, hence the exchange instead of a plain store.
+ */
+
+#define SLIST_SPSC_DECLARE_WITH_STORAGE(T, storage_) \
+SLIST_SPSC(T) { \
+    SLIST_CACHE_ALIGNED SLIST_NODE(T)* tail; \
+    SLIST_CACHE_ALIGNED SLIST_NODE(T)* head; \
+    SLIST_NODE(T) stub; \
+}; \
+storage_ void SLIST_spsc_init_##T(SLIST_SPSC(T)* queue); \
+storage_ void SLIST_spsc_push_##T(SLIST_SPSC(T)* queue, SLIST_NODE(T)* node); \
+storage_ SLIST_NODE(T)* SLIST_spsc_pop_##T(SLIST_SPSC(T)* queue)
+
+#define SLIST_SPSC_DEFINE_WITH_STORAGE(T, storage_) \
+storage_ void SLIST_spsc_init_##T(SLIST_SPSC(T)* queue) \
+{ \
+    queue->stub.next = NULL; \
+    queue->head = &queue->stub; \
+    queue->tail = &queue->stub; \
+} \
+\
+storage_ void SLIST_spsc_push_##T(SLIST_SPSC(T)* queue, SLIST_NODE(T)* node) \
+{ \
+    SLIST_NODE(T)* previous; \
+    SLIST_SPSC_STORE_RELAXED(&node->next, (SLIST_NODE(T)*)NULL); \
+    previous = SLIST_SPSC_EXCHANGE(&queue->tail, node); \
+    SLIST_SPSC_YIELD(); \
+    SLIST_SPSC_STORE_RELEASE(&previous->next, node); \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_spsc_pop_##T(SLIST_SPSC(T)* queue) \
+{ \
+    SLIST_NODE(T)* head = queue->head; \
+    SLIST_NODE(T)* next = SLIST_SPSC_LOAD_ACQUIRE(&head->next); \
+    SLIST_SPSC_YIELD(); \
+    if (head == &queue->stub) \
+    { \
+        if (next == NULL) \
+        { \
+            return NULL; \
+        } \
+        queue->head = next; \
+        head = next; \
+        next = SLIST_SPSC_LOAD_ACQUIRE(&next->next); \
+    } \
+    if (next == NULL) \
+    { \
+        SLIST_SPSC_YIELD(); \
+        if (head != SLIST_SPSC_LOAD_ACQUIRE(&queue->tail)) \
+        { \
+            /* A push is linking its node behind head */ \
+            return NULL; \
+        } \
+        SLIST_spsc_push_##T(queue, &queue->stub); \
+        SLIST_SPSC_YIELD(); \
+        next = SLIST_SPSC_LOAD_ACQUIRE(&head->next); \
+        if (next == NULL) \
+        { \
+            return NULL; \
+        } \
+    } \
+    queue->head = next; \
+    head->next = NULL; \
+    return head; \
+}
+
+#endif /* SLIST_SPSC_TEMPLATE_H_ */
+
+/*************************************************************************//**
+ *    End of file
+ *    }@
+ ***************************************************************************/
@@ -112,6 +112,400 @@
  ****************************************************************************/
 #include <stddef.h>
 
+#if defined(SLIST_ENABLE_STATS) && !defined(SLIST_STATS_PRINTF)
+#include <stdio.h>
+#endif
+
+#ifdef SLIST_ENABLE_USDT
+#include <sys/sdt.h>
+#endif
+
+#if defined(SLIST_ENABLE_VALIDATION) && !defined(SLIST_ASSERT)
+#include <assert.h>
+#endif
+
+/*****************************************************************************
+ * CONFIGURATION
+ ****************************************************************************/
+
+/*
+ * Compile time checks
+ *
+ * SLIST_STATIC_ASSERT(cond, name) fails the build when cond is false, name
+ * has to be an identifier unique in the scope (used by the C99 fallback).
+ */
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define SLIST_STATIC_ASSERT(cond_, name_) static_assert((cond_), #name_)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SLIST_STATIC_ASSERT(cond_, name_) _Static_assert((cond_), #name_)
+#else
+#define SLIST_STATIC_ASSERT(cond_, name_) \
+typedef char slistStaticAssert_##name_[(cond_) ? 1 : -1] SLIST_MAYBE_UNUSED
+#endif
+
+/*
+ * Instrumentation (opt-in, compiled out by default)
+ *
+ * Define SLIST_ENABLE_STATS in the build defines (or before including this
+ * header, consistently in every module) to make each instantiation account
+ * the operations done over its lists:
+ *
+ *	adds		nodes successfully appended
+ *	duplicates	appends rejected because the node was already on the list
+ *	steps		nodes visited by the add walk, in total
+ *	max_walk	longest single add walk (high-water mark)
+ *	max_length	longest list seen by an add (high-water mark)
+ *	pops		nodes taken from the head of a list
+ *
+ * Counters are per instantiation (per T), not per list, and are not
+ * protected against concurrent access.
+ *
+ * SLIST_STATS_PRINTF can be defined to a printf-like function to redirect
+ * the output of SLIST_STATS_DUMP(T), it defaults to printf.
+ */
+
+#ifdef SLIST_ENABLE_STATS
+
+#ifndef SLIST_STATS_PRINTF
+#define SLIST_STATS_PRINTF printf
+#endif
+
+#define SLIST_STATS_TYPE(T) \
+struct sSLIST_##T##_Stats
+
+#define SLIST_STATS(T) \
+((const SLIST_STATS_TYPE(T)*)&SLIST_stats_##T)
+
+#define SLIST_STATS_RESET(T) \
+((void)(SLIST_stats_##T = (SLIST_STATS_TYPE(T)){0}))
+
+#define SLIST_STATS_DUMP(T) \
+SLIST_dump_stats_##T()
+
+#define SLIST_DECLARE_STATS(T, storage_) \
+SLIST_STATS_TYPE(T) { \
+    size_t adds; \
+    size_t duplicates; \
+    size_t steps; \
+    size_t max_walk; \
+    size_t max_length; \
+    size_t pops; \
+}; \
+storage_ SLIST_STATS_TYPE(T) SLIST_stats_##T; \
+storage_ SLIST_MAYBE_UNUSED void SLIST_dump_stats_##T(void);
+
+#define SLIST_DEFINE_STATS(T, storage_) \
+storage_ SLIST_STATS_TYPE(T) SLIST_stats_##T; \
+storage_ SLIST_MAYBE_UNUSED void SLIST_dump_stats_##T(void) \
+{ \
+    SLIST_STATS_PRINTF("slist<%s>: adds=%lu duplicates=%lu steps=%lu " \
+        "max_walk=%lu max_length=%lu pops=%lu\n", #T, \
+        (unsigned long)SLIST_stats_##T.adds, \
+        (unsigned long)SLIST_stats_##T.duplicates, \
+        (unsigned long)SLIST_stats_##T.steps, \
+        (unsigned long)SLIST_stats_##T.max_walk, \
+        (unsigned long)SLIST_stats_##T.max_length, \
+        (unsigned long)SLIST_stats_##T.pops); \
+}
+
+#define SLIST_STATS_ON_DUPLICATE(T) \
+do { \
+    SLIST_stats_##T.duplicates++; \
+    SLIST_STATS_ACCOUNT_WALK(T); \
+} while (0)
+
+#define SLIST_STATS_ON_ADD(T) \
+do { \
+    SLIST_stats_##T.adds++; \
+    SLIST_STATS_ACCOUNT_WALK(T); \
+    if (slistWalk + 1 > SLIST_stats_##T.max_length) \
+    { \
+        SLIST_stats_##T.max_length = slistWalk + 1; \
+    } \
+} while (0)
+
+#define SLIST_STATS_ON_POP(T) \
+(SLIST_stats_##T.pops++)
+
+#define SLIST_STATS_ACCOUNT_WALK(T) \
+do { \
+    SLIST_stats_##T.steps += slistWalk; \
+    if (slistWalk > SLIST_stats_##T.max_walk) \
+    { \
+        SLIST_stats_##T.max_walk = slistWalk; \
+    } \
+} while (0)
+
+#else
+
+#define SLIST_STATS_DUMP(T) ((void)0)
+#define SLIST_DECLARE_STATS(T, storage_)
+#define SLIST_DEFINE_STATS(T, storage_)
+#define SLIST_STATS_ON_DUPLICATE(T) ((void)0)
+#define SLIST_STATS_ON_ADD(T) ((void)0)
+#define SLIST_STATS_ON_POP(T) ((void)0)
+
+#endif /* SLIST_ENABLE_STATS */
+
+/*
+ * Static tracepoints (opt-in, compiled out by default)
+ *
+ * Define SLIST_ENABLE_USDT to place USDT probes (<sys/sdt.h>, provider
+ * "slist") in the list operations. A probe not being traced is a single
+ * NOP, so they can be left enabled in production builds and attached
+ * later with perf or bpftrace, see scripts/ for some examples.
+ *
+ *	add_begin(type, head, node)		on entry of an add
+ *	add(type, head, node, walk)		node appended after walking `walk` nodes
+ *	duplicate(type, head, node, walk)	node rejected, already on the list
+ *	pop(type, head, node)			node taken from the head, head is the new one
+ *	walk_begin(type, head)			SLIST_FOR_EACH_NODE_PTR starts
+ *	walk_end(type, head)			SLIST_FOR_EACH_NODE_PTR reaches the end
+ *
+ * `type` is the instantiation name as a C string. Leaving a for each
+ * through break or return does not fire walk_end.
+ */
+
+#ifdef SLIST_ENABLE_USDT
+
+#define SLIST_PROBE_ADD_BEGIN(T, head_, node_) \
+DTRACE_PROBE3(slist, add_begin, #T, (head_), (node_))
+
+#define SLIST_PROBE_ADD(T, head_, node_) \
+DTRACE_PROBE4(slist, add, #T, (head_), (node_), slistWalk)
+
+#define SLIST_PROBE_DUPLICATE(T, head_, node_) \
+DTRACE_PROBE4(slist, duplicate, #T, (head_), (node_), slistWalk)
+
+#define SLIST_PROBE_POP(T, head_, node_) \
+DTRACE_PROBE3(slist, pop, #T, (head_), (node_))
+
+#define SLIST_PROBE_WALK_BEGIN(T, head_) \
+((SLIST_NODE(T)*)SLIST_probe_walk_begin(#T, (head_)))
+
+#define SLIST_PROBE_WALK_END(T, head_) \
+SLIST_probe_walk_end(#T, (head_))
+
+/* For each loops need the probes as expressions */
+static inline void* SLIST_probe_walk_begin(const char* type, void* head)
+{
+    DTRACE_PROBE2(slist, walk_begin, type, head);
+    return head;
+}
+
+static inline int SLIST_probe_walk_end(const char* type, void* head)
+{
+    DTRACE_PROBE2(slist, walk_end, type, head);
+    return 0;
+}
+
+#else
+
+#define SLIST_PROBE_ADD_BEGIN(T, head_, node_) ((void)0)
+#define SLIST_PROBE_ADD(T, head_, node_) ((void)0)
+#define SLIST_PROBE_DUPLICATE(T, head_, node_) ((void)0)
+#define SLIST_PROBE_POP(T, head_, node_) ((void)0)
+#define SLIST_PROBE_WALK_BEGIN(T, head_) (head_)
+#define SLIST_PROBE_WALK_END(T, head_) 0
+
+#endif /* SLIST_ENABLE_USDT */
+
+/*
+ * Structure validation (opt-in, debug builds only)
+ *
+ * Define SLIST_ENABLE_VALIDATION to check the list invariants on entry and
+ * after every mutation, and before every SLIST_FOR_EACH_NODE_PTR, so that a
+ * corrupted (circular) list is reported where it is detected instead of
+ * hanging a traversal later. Cycles are found with Brent's algorithm, in
+ * O(N) time and O(1) memory. The headers of bounded and counted lists are
+ * checked as well: count (and tail) have to agree with the nodes linked.
+ *
+ * Failures are reported through SLIST_ASSERT(expr, msg), an expression
+ * which defaults to assert(). Define it to route the report elsewhere; if
+ * it returns the operation carries on over the corrupted list.
+ *
+ * SLIST_IS_VALID(T, list), SLIST_BOUNDED_IS_VALID(T, MAX, list) and
+ * SLIST_COUNTED_IS_VALID(T, list) can also be queried directly in this mode.
+ * Without SLIST_ENABLE_VALIDATION none of the checks exist in the generated
+ * code.
+ */
+
+#ifdef SLIST_ENABLE_VALIDATION
+
+#ifndef SLIST_ASSERT
+#define SLIST_ASSERT(expr_, msg_) assert((expr_) && (msg_))
+#endif
+
+#define SLIST_IS_VALID(T, head_) \
+SLIST_validate_##T(head_)
+
+#define SLIST_VALIDATE_LIST(T, head_) \
+SLIST_ASSERT(SLIST_validate_##T(head_), "slist<" #T "> is circular")
+
+#define SLIST_VALIDATE_WALK(T, head_) \
+(SLIST_VALIDATE_LIST(T, head_), (head_))
+
+#define SLIST_BOUNDED_IS_VALID(T, MAX, list_) \
+SLIST_BOUNDED_FUNC(validate, T, MAX)(&(list_))
+
+#define SLIST_VALIDATE_BOUNDED(T, MAX, list_) \
+SLIST_ASSERT(SLIST_BOUNDED_FUNC(validate, T, MAX)(list_), "slist<" #T "> bounded header is inconsistent")
+
+#define SLIST_COUNTED_IS_VALID(T, list_) \
+SLIST_counted_validate_##T(&(list_))
+
+#define SLIST_VALIDATE_COUNTED(T, list_) \
+SLIST_ASSERT(SLIST_counted_validate_##T(list_), "slist<" #T "> counted header is inconsistent")
+
+#define SLIST_DECLARE_VALIDATION(T, storage_) \
+storage_ int SLIST_validate_##T(const SLIST_NODE(T)* head);
+
+#define SLIST_DEFINE_VALIDATION(T, storage_) \
+storage_ int SLIST_validate_##T(const SLIST_NODE(T)* head) \
+{ \
+    const SLIST_NODE(T)* tortoise = head; \
+    const SLIST_NODE(T)* hare = head; \
+    size_t power = 1; \
+    size_t lambda = 0; \
+    while (hare != NULL) \
+    { \
+        hare = hare->next; \
+        lambda++; \
+        if (hare == tortoise) \
+        { \
+            return 0; \
+        } \
+        if (lambda == power) \
+        { \
+            tortoise = hare; \
+            power *= 2; \
+            lambda = 0; \
+        } \
+    } \
+    return 1; \
+}
+
+/* Cycles first, so that the walks counting the nodes end */
+#define SLIST_DECLARE_BOUNDED_VALIDATION(T, MAX, storage_) \
+storage_ int SLIST_BOUNDED_FUNC(validate, T, MAX)(const SLIST_BOUNDED(T, MAX)* list);
+
+#define SLIST_DEFINE_BOUNDED_VALIDATION(T, MAX, storage_) \
+storage_ int SLIST_BOUNDED_FUNC(validate, T, MAX)(const SLIST_BOUNDED(T, MAX)* list) \
+{ \
+    const SLIST_NODE(T)* last = NULL; \
+    size_t count = 0; \
+    if (!SLIST_validate_##T(list->head)) \
+    { \
+        return 0; \
+    } \
+    for (const SLIST_NODE(T)* node = list->head; node != NULL; node = node->next) \
+    { \
+        last = node; \
+        count++; \
+    } \
+    return count == list->count && last == list->tail && count <= (MAX); \
+}
+
+#define SLIST_DECLARE_COUNTED_VALIDATION(T, storage_) \
+storage_ int SLIST_counted_validate_##T(const SLIST_COUNTED(T)* list);
+
+#define SLIST_DEFINE_COUNTED_VALIDATION(T, storage_) \
+storage_ int SLIST_counted_validate_##T(const SLIST_COUNTED(T)* list) \
+{ \
+    size_t count = 0; \
+    if (!SLIST_validate_##T(list->head)) \
+    { \
+        return 0; \
+    } \
+    for (const SLIST_NODE(T)* node = list->head; node != NULL; node = node->next) \
+    { \
+        count++; \
+    } \
+    return count == list->count; \
+}
+
+#else
+
+#define SLIST_VALIDATE_LIST(T, head_) ((void)0)
+#define SLIST_VALIDATE_WALK(T, head_) (head_)
+#define SLIST_VALIDATE_BOUNDED(T, MAX, list_) ((void)0)
+#define SLIST_VALIDATE_COUNTED(T, list_) ((void)0)
+#define SLIST_DECLARE_VALIDATION(T, storage_)
+#define SLIST_DEFINE_VALIDATION(T, storage_)
+#define SLIST_DECLARE_BOUNDED_VALIDATION(T, MAX, storage_)
+#define SLIST_DEFINE_BOUNDED_VALIDATION(T, MAX, storage_)
+#define SLIST_DECLARE_COUNTED_VALIDATION(T, storage_)
+#define SLIST_DEFINE_COUNTED_VALIDATION(T, storage_)
+
+#endif /* SLIST_ENABLE_VALIDATION */
+
+/*
+ * Node layout
+ *
+ * SLIST_CACHE_LINE is the line size nodes are aligned to by the
+ * SLIST_LAYOUT_ALIGNED layout. Alignment needs C11, C++11 or a GNU compatible
+ * compiler, elsewhere SLIST_LAYOUT_ALIGNED falls back to the plain
+ * SLIST_LAYOUT_NEXT_FIRST layout. Packing needs a GNU compatible compiler,
+ * elsewhere SLIST_LAYOUT_PACKED keeps the SLIST_LAYOUT_DEFAULT one (data then
+ * next, padded). SLIST_NODE_PADDING shows either fallback.
+ */
+
+#ifndef SLIST_CACHE_LINE
+#define SLIST_CACHE_LINE 64
+#endif
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define SLIST_ALIGNAS(bytes_) alignas(bytes_)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SLIST_ALIGNAS(bytes_) _Alignas(bytes_)
+#elif defined(__GNUC__)
+#define SLIST_ALIGNAS(bytes_) __attribute__((aligned(bytes_)))
+#else
+#define SLIST_ALIGNAS(bytes_)
+#endif
+
+/* Alignment a type needs, for allocators of nodes */
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define SLIST_ALIGNOF(type_) alignof(type_)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SLIST_ALIGNOF(type_) _Alignof(type_)
+#elif defined(__GNUC__)
+#define SLIST_ALIGNOF(type_) __alignof__(type_)
+#else
+#define SLIST_ALIGNOF(type_) offsetof(struct { char c; type_ t; }, t)
+#endif
+
+#if defined(__GNUC__)
+#define SLIST_PACKED __attribute__((packed))
+#else
+#define SLIST_PACKED
+#endif
+
+/*
+ * For what every instantiation gets but many programs never use (add and pop,
+ * e.g. with pools, the stats dump, and the C99 static assert typedefs), so
+ * that static instances do not warn
+ */
+
+#if defined(__GNUC__)
+#define SLIST_MAYBE_UNUSED __attribute__((unused))
+#else
+#define SLIST_MAYBE_UNUSED
+#endif
+
+/*
+ * Length of the add walk, only counted when somebody consumes it
+ */
+
+#if defined(SLIST_ENABLE_STATS) || defined(SLIST_ENABLE_USDT)
+#define SLIST_WALK_BEGIN() size_t slistWalk = 0
+#define SLIST_WALK_STEP() (slistWalk++)
+#else
+#define SLIST_WALK_BEGIN() ((void)0)
+#define SLIST_WALK_STEP() ((void)0)
+#endif
+
 /*****************************************************************************
  * MACROS
  ****************************************************************************/
@@ -124,12 +518,10 @@
  */
 
 #define SLIST_DECLARE(T) \
-SLIST_DECLARE_NODE_TYPE(T); \
-SLIST_DECLARE_ADD_NODE_FUNC(T)
+SLIST_DECLARE_WITH_STORAGE(T, extern)
 
 #define SLIST_DECLARE_STATIC(T) \
-SLIST_DECLARE_NODE_TYPE(T); \
-static SLIST_DECLARE_ADD_NODE_FUNC(T)
+SLIST_DECLARE_WITH_STORAGE(T, static)
 
 /*
  * Use either:
@@ -139,10 +531,50 @@ static SLIST_DECLARE_ADD_NODE_FUNC(T)
  */
 
 #define SLIST_DEFINE(T) \
-SLIST_DEFINE_ADD_NODE_FUNC(T)
+SLIST_DEFINE_WITH_STORAGE(T, )
 
 #define SLIST_DEFINE_STATIC(T) \
-static SLIST_DEFINE_ADD_NODE_FUNC(T)
+SLIST_DEFINE_WITH_STORAGE(T, static)
+
+/*
+ * Node layouts, to declare instead of SLIST_DECLARE(T) / SLIST_DECLARE_STATIC(T)
+ * with SLIST_DECLARE_LAYOUT(T, layout) / SLIST_DECLARE_LAYOUT_STATIC(T, layout).
+ * The definition does not change.
+ *
+ * - SLIST_LAYOUT_DEFAULT: data then next, as SLIST_DECLARE(T)
+ * - SLIST_LAYOUT_NEXT_FIRST: next then data, so that walks over a large T
+ *   only touch the first line of each node
+ * - SLIST_LAYOUT_ALIGNED: next first and every node aligned to (and a
+ *   multiple of) SLIST_CACHE_LINE, so nodes never share or straddle lines
+ * - SLIST_LAYOUT_PACKED: data then next with no padding at all, smallest
+ *   footprint at the cost of unaligned access to next
+ *
+ * The resulting layout can be checked at compile time:
+ *
+ *	SLIST_NODE_SIZE(T)				// bytes of a node<T>
+ *	SLIST_NODE_NEXT_OFFSET(T)		// offset of next inside the node
+ *	SLIST_NODE_PADDING(T)			// bytes that are neither data nor next
+ *	SLIST_ASSERT_NODE_LAYOUT(T, maxSize, maxPadding);	// fails the build otherwise
+ */
+
+#define SLIST_DECLARE_LAYOUT(T, layout_) \
+SLIST_DECLARE_WITH_LAYOUT(T, layout_, extern)
+
+#define SLIST_DECLARE_LAYOUT_STATIC(T, layout_) \
+SLIST_DECLARE_WITH_LAYOUT(T, layout_, static)
+
+#define SLIST_NODE_SIZE(T) \
+sizeof(SLIST_NODE(T))
+
+#define SLIST_NODE_NEXT_OFFSET(T) \
+offsetof(SLIST_NODE(T), next)
+
+#define SLIST_NODE_PADDING(T) \
+(sizeof(SLIST_NODE(T)) - sizeof(T) - sizeof(SLIST_NODE(T)*))
+
+#define SLIST_ASSERT_NODE_LAYOUT(T, maxSize_, maxPadding_) \
+SLIST_STATIC_ASSERT(SLIST_NODE_SIZE(T) <= (maxSize_) && SLIST_NODE_PADDING(T) <= (maxPadding_), \
+    sSLIST_##T##_NodeLayout)
 
 /*
  * Usage:
@@ -150,7 +582,15 @@ static SLIST_DEFINE_ADD_NODE_FUNC(T)
  *	SLIST_CREATE_LIST(T, list);		// creates a list<T>
  * 	SLIST_NODE(T) node; 			// declares a node<T>
  * 	node.data = data;				// assigns data to node<T>
- * 	SLIST_ADD_NODE(T, node)			// adds node<T> to list without repetition
+ * 	SLIST_ADD_NODE(T, node)			// adds node<T> to list without repetition, 0 if repeated
+ * 	SLIST_POP_NODE(T, list)			// takes the oldest node<T>, NULL if empty
+ * 	SLIST_PARTITION(T, list, lists, k, classify, context)	// see below
+ * 	SLIST_DEDUP(T, list, hash, eq, slots, capacity)		// see below
+ * 	SLIST_MERGE(T, a, b, less)				// see below
+ * 	SLIST_MERGE_K(T, lists, k, less, heap)
+ * 	SLIST_REVERSE(T, list)				// reversed in place, returns the new tail
+ * 	SLIST_ROTATE(T, list, k)			// node k becomes the head, returns the new tail
+ * 	SLIST_SPLIT_AT(T, list, k)			// list keeps k nodes, returns the rest
  * 	SLIST_FOR_EACH_NODE_PTR(T, list, node)
  * 	{
  * 		node->data
@@ -169,44 +609,1188 @@ SLIST_add_##T(&(head_), &(node_))
 #define SLIST_ADD_NODE_PTR(T, head_, node_) \
 SLIST_add_##T(&(head_), (node_))
 
+#define SLIST_POP_NODE(T, head_) \
+SLIST_pop_##T(&(head_))
+
+/*
+ * Moves in a single pass every node of list to lists[classify(&node->data,
+ * context)], a node classified k or above staying on list. Relative order is
+ * kept in every list. Each node is visited once and no memory is needed,
+ * although nodes already on the destinations are walked once to find their
+ * tails. Returns the number of nodes moved. Instantiated after the list,
+ * only for the types using it:
+ *
+ *	SLIST_DECLARE_PARTITION(T) / SLIST_DECLARE_PARTITION_STATIC(T)
+ *	SLIST_DEFINE_PARTITION(T) / SLIST_DEFINE_PARTITION_STATIC(T)
+ *
+ *	size_t by_type(const sMessage* message, void* context) { return message->type; }
+ *
+ *	SLIST_NODE(sMessage)* perType[TYPES] = { NULL };
+ *	SLIST_PARTITION(sMessage, incoming, perType, TYPES, by_type, NULL);
+ */
+#define SLIST_PARTITION(T, head_, lists_, k_, classify_, context_) \
+SLIST_partition_##T(&(head_), (lists_), (k_), (classify_), (context_))
+
+#define SLIST_DECLARE_PARTITION(T) \
+SLIST_DECLARE_PARTITION_WITH_STORAGE(T, extern)
+
+#define SLIST_DECLARE_PARTITION_STATIC(T) \
+SLIST_DECLARE_PARTITION_WITH_STORAGE(T, static)
+
+#define SLIST_DEFINE_PARTITION(T) \
+SLIST_DEFINE_PARTITION_WITH_STORAGE(T, )
+
+#define SLIST_DEFINE_PARTITION_STATIC(T) \
+SLIST_DEFINE_PARTITION_WITH_STORAGE(T, static)
+
+/*
+ * Removes the nodes whose value equals the one of a previous node, keeping
+ * the first occurrence of every value in order, in expected O(N). Values are
+ * recorded in a hash set of node pointers provided by the caller, slots being
+ * an array of capacity SLIST_NODE(T)* (contents ignored, at least the number
+ * of distinct values, twice that for short probes). Once the set is full new
+ * values are kept but not recorded, so their repetitions are not removed.
+ * Returns the removed nodes as a list, for the caller to recycle them.
+ * Instantiated after the list, only for the types using it:
+ *
+ *	SLIST_DECLARE_DEDUP(T) / SLIST_DECLARE_DEDUP_STATIC(T)
+ *	SLIST_DEFINE_DEDUP(T) / SLIST_DEFINE_DEDUP_STATIC(T)
+ *
+ *	size_t hash(const T* data);
+ *	int eq(const T* a, const T* b);		// non zero when equal
+ *
+ *	SLIST_NODE(uint32_t)* slots[2 * MAX_NODES];
+ *	SLIST_NODE(uint32_t)* removed = SLIST_DEDUP(uint32_t, list, hash, eq, slots, 2 * MAX_NODES);
+ */
+#define SLIST_DEDUP(T, head_, hash_, eq_, slots_, capacity_) \
+SLIST_dedup_##T(&(head_), (hash_), (eq_), (slots_), (capacity_))
+
+#define SLIST_DECLARE_DEDUP(T) \
+SLIST_DECLARE_DEDUP_WITH_STORAGE(T, extern)
+
+#define SLIST_DECLARE_DEDUP_STATIC(T) \
+SLIST_DECLARE_DEDUP_WITH_STORAGE(T, static)
+
+#define SLIST_DEFINE_DEDUP(T) \
+SLIST_DEFINE_DEDUP_WITH_STORAGE(T, )
+
+#define SLIST_DEFINE_DEDUP_STATIC(T) \
+SLIST_DEFINE_DEDUP_WITH_STORAGE(T, static)
+
+/*
+ * Merges lists already sorted by less into a single sorted list, in linear
+ * time and relinking the nodes, never copying data. Both merges are stable:
+ * of equal nodes those of a come before those of b, and those of lists[i]
+ * before those of lists[j] for i < j. The result is returned and the inputs
+ * are consumed (lists[] is left all NULL).
+ *
+ * The k-way merge picks the next node from a binary heap of the k list
+ * heads, O(N log k), the heap being an array of k size_t from the caller.
+ * Both are instantiated after the list, only for the types using them:
+ *
+ *	SLIST_DECLARE_MERGE(T) / SLIST_DECLARE_MERGE_STATIC(T)
+ *	SLIST_DEFINE_MERGE(T) / SLIST_DEFINE_MERGE_STATIC(T)
+ *
+ *	int less(const T* a, const T* b);		// non zero when a goes before b
+ *
+ *	timeline = SLIST_MERGE(sEvent, timeline, incoming, by_time);
+ *	size_t heap[SOURCES];
+ *	timeline = SLIST_MERGE_K(sEvent, perSource, SOURCES, by_time, heap);
+ */
+#define SLIST_MERGE(T, a_, b_, less_) \
+SLIST_merge_##T((a_), (b_), (less_))
+
+#define SLIST_MERGE_K(T, lists_, k_, less_, heap_) \
+SLIST_merge_k_##T((lists_), (k_), (less_), (heap_))
+
+#define SLIST_DECLARE_MERGE(T) \
+SLIST_DECLARE_MERGE_WITH_STORAGE(T, extern)
+
+#define SLIST_DECLARE_MERGE_STATIC(T) \
+SLIST_DECLARE_MERGE_WITH_STORAGE(T, static)
+
+#define SLIST_DEFINE_MERGE(T) \
+SLIST_DEFINE_MERGE_WITH_STORAGE(T, )
+
+#define SLIST_DEFINE_MERGE_STATIC(T) \
+SLIST_DEFINE_MERGE_WITH_STORAGE(T, static)
+
+/*
+ * Reordering in place, in a single pass and relinking the nodes. Reversing
+ * turns a LIFO accumulated chain (e.g. drained from a stack) into FIFO order.
+ * Rotating by k moves the first k nodes, in order, to the end: it walks the
+ * list once, plus k mod length steps when k is not below the length.
+ * Splitting walks only k nodes. The three are instantiated after the list,
+ * only for the types using them:
+ *
+ *	SLIST_DECLARE_REORDER(T) / SLIST_DECLARE_REORDER_STATIC(T)
+ *	SLIST_DEFINE_REORDER(T) / SLIST_DEFINE_REORDER_STATIC(T)
+ */
+#define SLIST_REVERSE(T, head_) \
+SLIST_reverse_##T(&(head_))
+
+#define SLIST_ROTATE(T, head_, k_) \
+SLIST_rotate_##T(&(head_), (k_))
+
+#define SLIST_SPLIT_AT(T, head_, k_) \
+SLIST_split_at_##T(&(head_), (k_))
+
+#define SLIST_DECLARE_REORDER(T) \
+SLIST_DECLARE_REORDER_WITH_STORAGE(T, extern)
+
+#define SLIST_DECLARE_REORDER_STATIC(T) \
+SLIST_DECLARE_REORDER_WITH_STORAGE(T, static)
+
+#define SLIST_DEFINE_REORDER(T) \
+SLIST_DEFINE_REORDER_WITH_STORAGE(T, )
+
+#define SLIST_DEFINE_REORDER_STATIC(T) \
+SLIST_DEFINE_REORDER_WITH_STORAGE(T, static)
+
+/* head_ is evaluated once, into a local named after the node */
 #define SLIST_FOR_EACH_NODE_PTR(T, head_, node_) \
-for (SLIST_NODE(T)* (node_) = (head_); (node_) != NULL ; (node_) = (node_)->next) \
+for (SLIST_NODE(T) *slistHead_##node_ = (head_), \
+     *(node_) = SLIST_PROBE_WALK_BEGIN(T, SLIST_VALIDATE_WALK(T, slistHead_##node_)); \
+     (node_) != NULL || SLIST_PROBE_WALK_END(T, slistHead_##node_); \
+     (node_) = (node_)->next) \
 
 /*
- * The templates themselves
+ * Padded lists
+ *
+ * A list header alone on its cache line (SLIST_CACHE_LINE), for arrays of
+ * lists written from different cores: with plain heads several of them share
+ * a line and every write on one invalidates the others (false sharing). The
+ * head is used with any list macro through SLIST_PADDED_HEAD:
+ *
+ *	static SLIST_PADDED_LIST(T) lists[CORES];
+ *	SLIST_ADD_NODE(T, SLIST_PADDED_HEAD(lists[core]), node);
+ *
+ * SLIST_CACHE_ALIGNED can be given to any member to start a new line in
+ * other headers, e.g. to separate producer and consumer state.
  */
 
-#define SLIST_DECLARE_NODE_TYPE(T) \
-SLIST_NODE(T) { \
-    T data; \
-    SLIST_NODE(T)* next; \
-}
+#define SLIST_PADDED_LIST(T) \
+struct sSLIST_##T##_PaddedList
 
-#define SLIST_DECLARE_ADD_NODE_FUNC(T) \
-void SLIST_add_##T(SLIST_NODE(T)** head, SLIST_NODE(T)* node)
+#define SLIST_CREATE_PADDED_LIST(T, list_) \
+SLIST_PADDED_LIST(T) list_ = { NULL, { 0 } }
 
-#define SLIST_DEFINE_ADD_NODE_FUNC(T) \
-SLIST_DECLARE_ADD_NODE_FUNC(T) \
-{ \
-    if (*head == NULL) \
-    { \
-        *head = node; \
-        node->next = NULL; \
-    } \
-    else \
-    { \
-        SLIST_NODE(T)* curr = *head; \
-        while (curr->next != NULL) \
-        { \
-            if (curr == node) \
-            { \
-                return; \
-            } \
-            curr = curr->next; \
-        } \
-        curr->next = node; \
-    } \
-    node->next = NULL; \
+#define SLIST_PADDED_HEAD(list_) \
+((list_).head)
+
+#define SLIST_CACHE_ALIGNED \
+SLIST_ALIGNAS(SLIST_CACHE_LINE)
+
+/*
+ * Cursors
+ *
+ * A cursor is a bookmark on a list: it remembers the last node visited so
+ * that a scan can be resumed, or nodes inserted and removed next to it,
+ * without walking again from the head. All the operations are O(1). Cursors
+ * are instantiated per type, after the list, only where they are used:
+ *
+ *	SLIST_DECLARE_CURSOR(T) / SLIST_DECLARE_CURSOR_STATIC(T)
+ *	SLIST_DEFINE_CURSOR(T) / SLIST_DEFINE_CURSOR_STATIC(T)
+ *
+ *	SLIST_CREATE_CURSOR(T, cursor, list);	// cursor before the first node
+ *	SLIST_CURSOR_NEXT(T, cursor)			// advances, returns the node or NULL
+ *	SLIST_CURSOR_NODE_PTR(cursor)			// node at the cursor, NULL before first
+ *	SLIST_CURSOR_INSERT_AFTER(T, cursor, node)	// links node right after the cursor
+ *	SLIST_CURSOR_REMOVE_AFTER(T, cursor)	// unlinks and returns the next node
+ *	SLIST_CURSOR_RESET(cursor)				// back before the first node
+ *
+ * When the end of the list is reached SLIST_CURSOR_NEXT returns NULL and the
+ * cursor stays on the last node, so nodes appended later are visited by the
+ * next call. Inserting after the cursor does not check for repetition, the
+ * node must not be on any list. The node at the cursor must not be removed
+ * from the list by other means while the cursor is in use.
+ */
+
+#define SLIST_CURSOR(T) \
+struct sSLIST_##T##_Cursor
+
+#define SLIST_CREATE_CURSOR(T, cursor_, head_) \
+SLIST_CURSOR(T) cursor_ = { &(head_), NULL }
+
+#define SLIST_CURSOR_NODE_PTR(cursor_) \
+((cursor_).node)
+
+#define SLIST_CURSOR_RESET(cursor_) \
+((void)((cursor_).node = NULL))
+
+#define SLIST_CURSOR_NEXT(T, cursor_) \
+SLIST_cursor_next_##T(&(cursor_))
+
+#define SLIST_CURSOR_INSERT_AFTER(T, cursor_, node_) \
+SLIST_cursor_insert_after_##T(&(cursor_), &(node_))
+
+#define SLIST_CURSOR_INSERT_AFTER_PTR(T, cursor_, node_) \
+SLIST_cursor_insert_after_##T(&(cursor_), (node_))
+
+#define SLIST_CURSOR_REMOVE_AFTER(T, cursor_) \
+SLIST_cursor_remove_after_##T(&(cursor_))
+
+#define SLIST_DECLARE_CURSOR(T) \
+SLIST_DECLARE_CURSOR_WITH_STORAGE(T, extern)
+
+#define SLIST_DECLARE_CURSOR_STATIC(T) \
+SLIST_DECLARE_CURSOR_WITH_STORAGE(T, static)
+
+#define SLIST_DEFINE_CURSOR(T) \
+SLIST_DEFINE_CURSOR_WITH_STORAGE(T, )
+
+#define SLIST_DEFINE_CURSOR_STATIC(T) \
+SLIST_DEFINE_CURSOR_WITH_STORAGE(T, static)
+
+/*
+ * Bounded lists
+ *
+ * A bounded list keeps head, tail and count in its header and never holds
+ * more than MAX nodes, so the worst case of any walk over it is known at
+ * compile time. They are instantiated per type and bound, after the list:
+ *
+ *	SLIST_DECLARE_BOUNDED(T, MAX) / SLIST_DECLARE_BOUNDED_STATIC(T, MAX)
+ *	SLIST_DEFINE_BOUNDED(T, MAX) / SLIST_DEFINE_BOUNDED_STATIC(T, MAX)
+ *
+ * MAX is pasted into the generated names, so it has to be a plain integer
+ * literal or a macro expanding to one (no parentheses, no suffix).
+ *
+ *	SLIST_CREATE_BOUNDED_LIST(T, MAX, list, policy);	// policy on overflow
+ *	SLIST_BOUNDED_ADD(T, MAX, list, node)	// node<T>* dropped, NULL if none
+ *	SLIST_BOUNDED_POP(T, MAX, list)			// oldest node<T>, NULL if empty
+ *	SLIST_BOUNDED_COUNT(list)				// O(1)
+ *	SLIST_BOUNDED_IS_FULL(MAX, list)		// O(1)
+ *	SLIST_FOR_EACH_NODE_PTR(T, SLIST_BOUNDED_HEAD(list), node)
+ *
+ * On overflow SLIST_DROP_NEW refuses the node being added and returns it,
+ * while SLIST_DROP_OLDEST evicts and returns the head to make room. Adding
+ * a node already on the list has no effect and returns NULL; that check
+ * walks at most MAX nodes, the append itself is O(1).
+ *
+ * SLIST_BOUNDED_ASSERT_FITS(MAX, capacity, name) checks at compile time that
+ * a node pool of the given capacity can fill the list.
+ *
+ * Reordering keeps tail and count up to date, and is instantiated apart,
+ * after the bounded list, only where it is used:
+ *
+ *	SLIST_DECLARE_BOUNDED_REORDER(T, MAX) / SLIST_DECLARE_BOUNDED_REORDER_STATIC(T, MAX)
+ *	SLIST_DEFINE_BOUNDED_REORDER(T, MAX) / SLIST_DEFINE_BOUNDED_REORDER_STATIC(T, MAX)
+ *
+ *	SLIST_BOUNDED_REVERSE(T, MAX, list)		// O(count)
+ *	SLIST_BOUNDED_ROTATE(T, MAX, list, k)	// O(k mod count)
+ *	SLIST_BOUNDED_SPLIT_AT(T, MAX, list, k)	// keeps k nodes, returns the rest, O(k)
+ */
+
+typedef enum {
+    SLIST_DROP_NEW,
+    SLIST_DROP_OLDEST
+} eSLIST_OverflowPolicy;
+
+#define SLIST_BOUNDED(T, MAX) \
+SLIST_BOUNDED_TYPE(T, MAX)
+
+#define SLIST_CREATE_BOUNDED_LIST(T, MAX, list_, policy_) \
+SLIST_BOUNDED(T, MAX) list_ = { NULL, NULL, 0, (policy_) }
+
+#define SLIST_BOUNDED_ADD(T, MAX, list_, node_) \
+SLIST_BOUNDED_FUNC(add, T, MAX)(&(list_), &(node_))
+
+#define SLIST_BOUNDED_ADD_PTR(T, MAX, list_, node_) \
+SLIST_BOUNDED_FUNC(add, T, MAX)(&(list_), (node_))
+
+#define SLIST_BOUNDED_POP(T, MAX, list_) \
+SLIST_BOUNDED_FUNC(pop, T, MAX)(&(list_))
+
+#define SLIST_BOUNDED_REVERSE(T, MAX, list_) \
+SLIST_BOUNDED_FUNC(reverse, T, MAX)(&(list_))
+
+#define SLIST_BOUNDED_ROTATE(T, MAX, list_, k_) \
+SLIST_BOUNDED_FUNC(rotate, T, MAX)(&(list_), (k_))
+
+#define SLIST_BOUNDED_SPLIT_AT(T, MAX, list_, k_) \
+SLIST_BOUNDED_FUNC(split_at, T, MAX)(&(list_), (k_))
+
+#define SLIST_BOUNDED_HEAD(list_) \
+((list_).head)
+
+#define SLIST_BOUNDED_COUNT(list_) \
+((list_).count)
+
+#define SLIST_BOUNDED_IS_FULL(MAX, list_) \
+((list_).count >= (MAX))
+
+#define SLIST_BOUNDED_ASSERT_FITS(MAX, capacity_, name_) \
+SLIST_STATIC_ASSERT((capacity_) >= (MAX), name_)
+
+#define SLIST_DECLARE_BOUNDED(T, MAX) \
+SLIST_DECLARE_BOUNDED_WITH_STORAGE(T, MAX, extern)
+
+#define SLIST_DECLARE_BOUNDED_STATIC(T, MAX) \
+SLIST_DECLARE_BOUNDED_WITH_STORAGE(T, MAX, static)
+
+#define SLIST_DEFINE_BOUNDED(T, MAX) \
+SLIST_DEFINE_BOUNDED_WITH_STORAGE(T, MAX, )
+
+#define SLIST_DEFINE_BOUNDED_STATIC(T, MAX) \
+SLIST_DEFINE_BOUNDED_WITH_STORAGE(T, MAX, static)
+
+#define SLIST_DECLARE_BOUNDED_REORDER(T, MAX) \
+SLIST_DECLARE_BOUNDED_REORDER_WITH_STORAGE(T, MAX, extern)
+
+#define SLIST_DECLARE_BOUNDED_REORDER_STATIC(T, MAX) \
+SLIST_DECLARE_BOUNDED_REORDER_WITH_STORAGE(T, MAX, static)
+
+#define SLIST_DEFINE_BOUNDED_REORDER(T, MAX) \
+SLIST_DEFINE_BOUNDED_REORDER_WITH_STORAGE(T, MAX, )
+
+#define SLIST_DEFINE_BOUNDED_REORDER_STATIC(T, MAX) \
+SLIST_DEFINE_BOUNDED_REORDER_WITH_STORAGE(T, MAX, static)
+
+/*
+ * Counted lists
+ *
+ * A list header with a count kept up to date by every operation, so that
+ * its size is O(1) instead of a walk. Only the types instantiating it pay
+ * for the field and the functions, after the list:
+ *
+ *	SLIST_DECLARE_COUNTED(T) / SLIST_DECLARE_COUNTED_STATIC(T)
+ *	SLIST_DEFINE_COUNTED(T) / SLIST_DEFINE_COUNTED_STATIC(T)
+ *
+ *	SLIST_CREATE_COUNTED_LIST(T, list);
+ *	SLIST_COUNTED_ADD(T, list, node)		// 0 if already on the list
+ *	SLIST_COUNTED_POP(T, list)				// oldest node<T>, NULL if empty
+ *	SLIST_COUNTED_REMOVE(T, list, node)		// 0 if not on the list, O(N)
+ *	SLIST_COUNTED_SPLICE(T, list, other)	// appends all of other, leaving it empty
+ *	SLIST_COUNTED_SIZE(list)				// O(1)
+ *	SLIST_FOR_EACH_NODE_PTR(T, SLIST_COUNTED_HEAD(list), node)
+ *
+ * The head must not be modified other than through these macros, or the
+ * count would drift.
+ */
+
+#define SLIST_COUNTED(T) \
+struct sSLIST_##T##_Counted
+
+#define SLIST_CREATE_COUNTED_LIST(T, list_) \
+SLIST_COUNTED(T) list_ = { NULL, 0 }
+
+#define SLIST_COUNTED_ADD(T, list_, node_) \
+SLIST_counted_add_##T(&(list_), &(node_))
+
+#define SLIST_COUNTED_ADD_PTR(T, list_, node_) \
+SLIST_counted_add_##T(&(list_), (node_))
+
+#define SLIST_COUNTED_POP(T, list_) \
+SLIST_counted_pop_##T(&(list_))
+
+#define SLIST_COUNTED_REMOVE(T, list_, node_) \
+SLIST_counted_remove_##T(&(list_), &(node_))
+
+#define SLIST_COUNTED_REMOVE_PTR(T, list_, node_) \
+SLIST_counted_remove_##T(&(list_), (node_))
+
+#define SLIST_COUNTED_SPLICE(T, list_, other_) \
+SLIST_counted_splice_##T(&(list_), &(other_))
+
+#define SLIST_COUNTED_SIZE(list_) \
+((list_).count)
+
+#define SLIST_COUNTED_HEAD(list_) \
+((list_).head)
+
+#define SLIST_DECLARE_COUNTED(T) \
+SLIST_DECLARE_COUNTED_WITH_STORAGE(T, extern)
+
+#define SLIST_DECLARE_COUNTED_STATIC(T) \
+SLIST_DECLARE_COUNTED_WITH_STORAGE(T, static)
+
+#define SLIST_DEFINE_COUNTED(T) \
+SLIST_DEFINE_COUNTED_WITH_STORAGE(T, )
+
+#define SLIST_DEFINE_COUNTED_STATIC(T) \
+SLIST_DEFINE_COUNTED_WITH_STORAGE(T, static)
+
+/*
+ * The templates themselves
+ *
+ * storage_ is the storage class every declaration and definition is
+ * prefixed with: extern/empty for public instances, static for private ones.
+ */
+
+#define SLIST_DECLARE_WITH_STORAGE(T, storage_) \
+SLIST_DECLARE_WITH_LAYOUT(T, SLIST_LAYOUT_DEFAULT, storage_)
+
+#define SLIST_DECLARE_WITH_LAYOUT(T, layout_, storage_) \
+SLIST_DECLARE_NODE_TYPE_##layout_(T); \
+SLIST_DECLARE_PADDED_LIST(T); \
+SLIST_DECLARE_STATS(T, storage_) \
+SLIST_DECLARE_VALIDATION(T, storage_) \
+storage_ SLIST_MAYBE_UNUSED SLIST_NODE(T)* SLIST_pop_##T(SLIST_NODE(T)** head); \
+storage_ SLIST_DECLARE_ADD_NODE_FUNC(T)
+
+#define SLIST_DEFINE_WITH_STORAGE(T, storage_) \
+SLIST_DEFINE_STATS(T, storage_) \
+SLIST_DEFINE_VALIDATION(T, storage_) \
+SLIST_DEFINE_POP_FUNC(T, storage_) \
+storage_ SLIST_DEFINE_ADD_NODE_FUNC(T)
+
+#define SLIST_DECLARE_NODE_TYPE(T) \
+SLIST_DECLARE_NODE_TYPE_SLIST_LAYOUT_DEFAULT(T)
+
+#define SLIST_DECLARE_NODE_TYPE_SLIST_LAYOUT_DEFAULT(T) \
+SLIST_NODE(T) { \
+    T data; \
+    SLIST_NODE(T)* next; \
+}
+
+#define SLIST_DECLARE_NODE_TYPE_SLIST_LAYOUT_NEXT_FIRST(T) \
+SLIST_NODE(T) { \
+    SLIST_NODE(T)* next; \
+    T data; \
+}
+
+#define SLIST_DECLARE_NODE_TYPE_SLIST_LAYOUT_ALIGNED(T) \
+SLIST_NODE(T) { \
+    SLIST_ALIGNAS(SLIST_CACHE_LINE) SLIST_NODE(T)* next; \
+    T data; \
+}
+
+#define SLIST_DECLARE_NODE_TYPE_SLIST_LAYOUT_PACKED(T) \
+SLIST_NODE(T) { \
+    T data; \
+    SLIST_NODE(T)* next; \
+} SLIST_PACKED
+
+/* The explicit padding keeps the size where alignment is not available */
+#define SLIST_DECLARE_PADDED_LIST(T) \
+SLIST_PADDED_LIST(T) { \
+    SLIST_CACHE_ALIGNED SLIST_NODE(T)* head; \
+    char padding[SLIST_CACHE_LINE - sizeof(SLIST_NODE(T)*)]; \
+}
+
+#define SLIST_DECLARE_ADD_NODE_FUNC(T) \
+SLIST_MAYBE_UNUSED int SLIST_add_##T(SLIST_NODE(T)** head, SLIST_NODE(T)* node)
+
+#define SLIST_DEFINE_ADD_NODE_FUNC(T) \
+SLIST_DECLARE_ADD_NODE_FUNC(T) \
+{ \
+    SLIST_WALK_BEGIN(); \
+    SLIST_PROBE_ADD_BEGIN(T, *head, node); \
+    SLIST_VALIDATE_LIST(T, *head); \
+    if (*head == NULL) \
+    { \
+        *head = node; \
+    } \
+    else \
+    { \
+        SLIST_NODE(T)* curr = *head; \
+        for (;;) \
+        { \
+            SLIST_WALK_STEP(); \
+            if (curr == node) \
+            { \
+                SLIST_STATS_ON_DUPLICATE(T); \
+                SLIST_PROBE_DUPLICATE(T, *head, node); \
+                return 0; \
+            } \
+            if (curr->next == NULL) \
+            { \
+                break; \
+            } \
+            curr = curr->next; \
+        } \
+        curr->next = node; \
+    } \
+    node->next = NULL; \
+    SLIST_STATS_ON_ADD(T); \
+    SLIST_PROBE_ADD(T, *head, node); \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return 1; \
+}
+
+#define SLIST_DECLARE_CURSOR_WITH_STORAGE(T, storage_) \
+SLIST_CURSOR(T) { \
+    SLIST_NODE(T)** head; \
+    SLIST_NODE(T)* node; \
+}; \
+storage_ SLIST_MAYBE_UNUSED SLIST_NODE(T)* SLIST_cursor_next_##T(SLIST_CURSOR(T)* cursor); \
+storage_ SLIST_MAYBE_UNUSED void SLIST_cursor_insert_after_##T(SLIST_CURSOR(T)* cursor, SLIST_NODE(T)* node); \
+storage_ SLIST_MAYBE_UNUSED SLIST_NODE(T)* SLIST_cursor_remove_after_##T(SLIST_CURSOR(T)* cursor)
+
+#define SLIST_DEFINE_CURSOR_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_cursor_next_##T(SLIST_CURSOR(T)* cursor) \
+{ \
+    SLIST_NODE(T)* next = (cursor->node == NULL) ? *cursor->head : cursor->node->next; \
+    if (next != NULL) \
+    { \
+        cursor->node = next; \
+    } \
+    return next; \
+} \
+\
+storage_ void SLIST_cursor_insert_after_##T(SLIST_CURSOR(T)* cursor, SLIST_NODE(T)* node) \
+{ \
+    /* Not through a pointer to next, which is unaligned in packed nodes */ \
+    if (cursor->node == NULL) \
+    { \
+        node->next = *cursor->head; \
+        *cursor->head = node; \
+    } \
+    else \
+    { \
+        node->next = cursor->node->next; \
+        cursor->node->next = node; \
+    } \
+    SLIST_VALIDATE_LIST(T, *cursor->head); \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_cursor_remove_after_##T(SLIST_CURSOR(T)* cursor) \
+{ \
+    SLIST_NODE(T)* node = (cursor->node == NULL) ? *cursor->head : cursor->node->next; \
+    if (node != NULL) \
+    { \
+        if (cursor->node == NULL) \
+        { \
+            *cursor->head = node->next; \
+        } \
+        else \
+        { \
+            cursor->node->next = node->next; \
+        } \
+        node->next = NULL; \
+    } \
+    SLIST_VALIDATE_LIST(T, *cursor->head); \
+    return node; \
+}
+
+/* Extra level so that MAX gets expanded before being pasted */
+#define SLIST_BOUNDED_TYPE(T, MAX) \
+struct sSLIST_##T##_Bounded_##MAX
+
+#define SLIST_BOUNDED_FUNC(name_, T, MAX) \
+SLIST_BOUNDED_FUNC_NAME(name_, T, MAX)
+
+#define SLIST_BOUNDED_FUNC_NAME(name_, T, MAX) \
+SLIST_bounded_##name_##_##T##_##MAX
+
+#define SLIST_DEFINE_POP_FUNC(T, storage_) \
+storage_ SLIST_MAYBE_UNUSED SLIST_NODE(T)* SLIST_pop_##T(SLIST_NODE(T)** head) \
+{ \
+    SLIST_NODE(T)* node = *head; \
+    if (node != NULL) \
+    { \
+        *head = node->next; \
+        node->next = NULL; \
+        SLIST_STATS_ON_POP(T); \
+        SLIST_PROBE_POP(T, *head, node); \
+    } \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return node; \
+}
+
+/*
+ * While partitioning every destination is kept circular and pointed to by
+ * its tail, so that both its tail and its first node are reachable in O(1)
+ * without any extra storage. They are opened again once the pass is over.
+ */
+#define SLIST_DECLARE_PARTITION_WITH_STORAGE(T, storage_) \
+storage_ size_t SLIST_partition_##T(SLIST_NODE(T)** head, SLIST_NODE(T)** lists, size_t k, \
+    size_t (*classify)(const T* data, void* context), void* context)
+
+#define SLIST_DEFINE_PARTITION_WITH_STORAGE(T, storage_) \
+storage_ size_t SLIST_partition_##T(SLIST_NODE(T)** head, SLIST_NODE(T)** lists, size_t k, \
+    size_t (*classify)(const T* data, void* context), void* context) \
+{ \
+    SLIST_NODE(T)* node = *head; \
+    SLIST_NODE(T)* kept = NULL; \
+    size_t moved = 0; \
+    size_t i; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    for (i = 0; i < k; i++) \
+    { \
+        SLIST_NODE(T)* tail = lists[i]; \
+        if (tail != NULL) \
+        { \
+            SLIST_VALIDATE_LIST(T, tail); \
+            while (tail->next != NULL) \
+            { \
+                tail = tail->next; \
+            } \
+            tail->next = lists[i]; \
+            lists[i] = tail; \
+        } \
+    } \
+    *head = NULL; \
+    while (node != NULL) \
+    { \
+        SLIST_NODE(T)* next = node->next; \
+        size_t index = classify(&node->data, context); \
+        if (index < k) \
+        { \
+            SLIST_NODE(T)* tail = lists[index]; \
+            node->next = (tail != NULL) ? tail->next : node; \
+            if (tail != NULL) \
+            { \
+                tail->next = node; \
+            } \
+            lists[index] = node; \
+            moved++; \
+        } \
+        else \
+        { \
+            node->next = NULL; \
+            if (kept == NULL) \
+            { \
+                *head = node; \
+            } \
+            else \
+            { \
+                kept->next = node; \
+            } \
+            kept = node; \
+        } \
+        node = next; \
+    } \
+    for (i = 0; i < k; i++) \
+    { \
+        SLIST_NODE(T)* tail = lists[i]; \
+        if (tail != NULL) \
+        { \
+            lists[i] = tail->next; \
+            tail->next = NULL; \
+            SLIST_VALIDATE_LIST(T, lists[i]); \
+        } \
+    } \
+    return moved; \
+}
+
+/* Open addressing with linear probing, never more than capacity probes */
+#define SLIST_DECLARE_DEDUP_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_dedup_##T(SLIST_NODE(T)** head, size_t (*hash)(const T* data), \
+    int (*eq)(const T* a, const T* b), SLIST_NODE(T)** slots, size_t capacity)
+
+#define SLIST_DEFINE_DEDUP_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_dedup_##T(SLIST_NODE(T)** head, size_t (*hash)(const T* data), \
+    int (*eq)(const T* a, const T* b), SLIST_NODE(T)** slots, size_t capacity) \
+{ \
+    SLIST_NODE(T)* node = *head; \
+    SLIST_NODE(T)* kept = NULL; \
+    SLIST_NODE(T)* removed = NULL; \
+    SLIST_NODE(T)* removedTail = NULL; \
+    size_t used = 0; \
+    size_t i; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    for (i = 0; i < capacity; i++) \
+    { \
+        slots[i] = NULL; \
+    } \
+    while (node != NULL) \
+    { \
+        SLIST_NODE(T)* next = node->next; \
+        int duplicate = 0; \
+        if (capacity != 0) \
+        { \
+            size_t probes; \
+            i = hash(&node->data) % capacity; \
+            for (probes = 0; probes < capacity && slots[i] != NULL; probes++) \
+            { \
+                if (eq(&slots[i]->data, &node->data)) \
+                { \
+                    duplicate = 1; \
+                    break; \
+                } \
+                i = (i + 1 == capacity) ? 0 : i + 1; \
+            } \
+            if (!duplicate && used < capacity) \
+            { \
+                slots[i] = node; \
+                used++; \
+            } \
+        } \
+        node->next = NULL; \
+        if (duplicate) \
+        { \
+            if (removedTail == NULL) \
+            { \
+                removed = node; \
+            } \
+            else \
+            { \
+                removedTail->next = node; \
+            } \
+            removedTail = node; \
+        } \
+        else \
+        { \
+            if (kept == NULL) \
+            { \
+                *head = node; \
+            } \
+            else \
+            { \
+                kept->next = node; \
+            } \
+            kept = node; \
+        } \
+        node = next; \
+    } \
+    if (kept == NULL) \
+    { \
+        *head = NULL; \
+    } \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return removed; \
+}
+
+/*
+ * Heap entries are list indexes, ordered by their head and then by index so
+ * that equal heads come out in list order.
+ */
+#define SLIST_DECLARE_MERGE_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_merge_##T(SLIST_NODE(T)* a, SLIST_NODE(T)* b, \
+    int (*less)(const T* a, const T* b)); \
+storage_ int SLIST_merge_before_##T(SLIST_NODE(T)** lists, size_t x, size_t y, \
+    int (*less)(const T* a, const T* b)); \
+storage_ SLIST_NODE(T)* SLIST_merge_k_##T(SLIST_NODE(T)** lists, size_t k, \
+    int (*less)(const T* a, const T* b), size_t* heap)
+
+#define SLIST_DEFINE_MERGE_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_merge_##T(SLIST_NODE(T)* a, SLIST_NODE(T)* b, \
+    int (*less)(const T* a, const T* b)) \
+{ \
+    SLIST_NODE(T)* head = NULL; \
+    SLIST_NODE(T)* tail = NULL; \
+    SLIST_VALIDATE_LIST(T, a); \
+    SLIST_VALIDATE_LIST(T, b); \
+    while (a != NULL && b != NULL) \
+    { \
+        SLIST_NODE(T)* node; \
+        if (less(&b->data, &a->data)) \
+        { \
+            node = b; \
+            b = b->next; \
+        } \
+        else \
+        { \
+            node = a; \
+            a = a->next; \
+        } \
+        if (tail == NULL) \
+        { \
+            head = node; \
+        } \
+        else \
+        { \
+            tail->next = node; \
+        } \
+        tail = node; \
+    } \
+    if (tail == NULL) \
+    { \
+        return (a != NULL) ? a : b; \
+    } \
+    tail->next = (a != NULL) ? a : b; \
+    SLIST_VALIDATE_LIST(T, head); \
+    return head; \
+} \
+\
+storage_ int SLIST_merge_before_##T(SLIST_NODE(T)** lists, size_t x, size_t y, \
+    int (*less)(const T* a, const T* b)) \
+{ \
+    if (less(&lists[x]->data, &lists[y]->data)) \
+    { \
+        return 1; \
+    } \
+    return !less(&lists[y]->data, &lists[x]->data) && x < y; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_merge_k_##T(SLIST_NODE(T)** lists, size_t k, \
+    int (*less)(const T* a, const T* b), size_t* heap) \
+{ \
+    SLIST_NODE(T)* head = NULL; \
+    SLIST_NODE(T)* tail = NULL; \
+    size_t count = 0; \
+    size_t i; \
+    for (i = 0; i < k; i++) \
+    { \
+        size_t at = count; \
+        if (lists[i] == NULL) \
+        { \
+            continue; \
+        } \
+        SLIST_VALIDATE_LIST(T, lists[i]); \
+        count++; \
+        while (at > 0 && SLIST_merge_before_##T(lists, i, heap[(at - 1) / 2], less)) \
+        { \
+            heap[at] = heap[(at - 1) / 2]; \
+            at = (at - 1) / 2; \
+        } \
+        heap[at] = i; \
+    } \
+    while (count > 0) \
+    { \
+        size_t first = heap[0]; \
+        SLIST_NODE(T)* node = lists[first]; \
+        size_t at = 0; \
+        lists[first] = node->next; \
+        if (tail == NULL) \
+        { \
+            head = node; \
+        } \
+        else \
+        { \
+            tail->next = node; \
+        } \
+        tail = node; \
+        if (lists[first] == NULL) \
+        { \
+            first = heap[--count]; \
+        } \
+        /* Sift the (new) head of first down from the root */ \
+        for (;;) \
+        { \
+            size_t child = 2 * at + 1; \
+            if (child >= count) \
+            { \
+                break; \
+            } \
+            if (child + 1 < count && SLIST_merge_before_##T(lists, heap[child + 1], heap[child], less)) \
+            { \
+                child++; \
+            } \
+            if (!SLIST_merge_before_##T(lists, heap[child], first, less)) \
+            { \
+                break; \
+            } \
+            heap[at] = heap[child]; \
+            at = child; \
+        } \
+        if (count > 0) \
+        { \
+            heap[at] = first; \
+        } \
+    } \
+    if (tail != NULL) \
+    { \
+        tail->next = NULL; \
+    } \
+    SLIST_VALIDATE_LIST(T, head); \
+    return head; \
+}
+
+#define SLIST_DECLARE_REORDER_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_reverse_##T(SLIST_NODE(T)** head); \
+storage_ SLIST_NODE(T)* SLIST_rotate_##T(SLIST_NODE(T)** head, size_t k); \
+storage_ SLIST_NODE(T)* SLIST_split_at_##T(SLIST_NODE(T)** head, size_t k)
+
+#define SLIST_DEFINE_REORDER_WITH_STORAGE(T, storage_) \
+storage_ SLIST_NODE(T)* SLIST_reverse_##T(SLIST_NODE(T)** head) \
+{ \
+    SLIST_NODE(T)* reversed = NULL; \
+    SLIST_NODE(T)* tail = *head; \
+    SLIST_NODE(T)* node = *head; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    while (node != NULL) \
+    { \
+        SLIST_NODE(T)* next = node->next; \
+        node->next = reversed; \
+        reversed = node; \
+        node = next; \
+    } \
+    *head = reversed; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return tail; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_rotate_##T(SLIST_NODE(T)** head, size_t k) \
+{ \
+    SLIST_NODE(T)* last = NULL; \
+    SLIST_NODE(T)* tail = *head; \
+    size_t length = 0; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    if (tail == NULL) \
+    { \
+        return NULL; \
+    } \
+    /* One walk to the tail, remembering the node k-1 on the way */ \
+    for (;;) \
+    { \
+        if (++length == k) \
+        { \
+            last = tail; \
+        } \
+        if (tail->next == NULL) \
+        { \
+            break; \
+        } \
+        tail = tail->next; \
+    } \
+    if (k >= length) \
+    { \
+        last = NULL; \
+        k %= length; \
+        if (k != 0) \
+        { \
+            last = *head; \
+            while (--k != 0) \
+            { \
+                last = last->next; \
+            } \
+        } \
+    } \
+    if (last == NULL) \
+    { \
+        return tail; \
+    } \
+    tail->next = *head; \
+    *head = last->next; \
+    last->next = NULL; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    return last; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_split_at_##T(SLIST_NODE(T)** head, size_t k) \
+{ \
+    SLIST_NODE(T)* last = *head; \
+    SLIST_NODE(T)* rest; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    if (k == 0) \
+    { \
+        rest = *head; \
+        *head = NULL; \
+        return rest; \
+    } \
+    while (last != NULL && --k != 0) \
+    { \
+        last = last->next; \
+    } \
+    if (last == NULL) \
+    { \
+        return NULL; \
+    } \
+    rest = last->next; \
+    last->next = NULL; \
+    SLIST_VALIDATE_LIST(T, *head); \
+    SLIST_VALIDATE_LIST(T, rest); \
+    return rest; \
+}
+
+#define SLIST_DECLARE_BOUNDED_WITH_STORAGE(T, MAX, storage_) \
+SLIST_STATIC_ASSERT((MAX) > 0, sSLIST_##T##_Bounded_##MAX##_IsNotEmpty); \
+SLIST_BOUNDED(T, MAX) { \
+    SLIST_NODE(T)* head; \
+    SLIST_NODE(T)* tail; \
+    size_t count; \
+    eSLIST_OverflowPolicy policy; \
+}; \
+SLIST_DECLARE_BOUNDED_VALIDATION(T, MAX, storage_) \
+storage_ SLIST_NODE(T)* SLIST_BOUNDED_FUNC(add, T, MAX)(SLIST_BOUNDED(T, MAX)* list, SLIST_NODE(T)* node); \
+storage_ SLIST_NODE(T)* SLIST_BOUNDED_FUNC(pop, T, MAX)(SLIST_BOUNDED(T, MAX)* list)
+
+#define SLIST_DEFINE_BOUNDED_WITH_STORAGE(T, MAX, storage_) \
+SLIST_DEFINE_BOUNDED_VALIDATION(T, MAX, storage_) \
+storage_ SLIST_NODE(T)* SLIST_BOUNDED_FUNC(pop, T, MAX)(SLIST_BOUNDED(T, MAX)* list) \
+{ \
+    SLIST_NODE(T)* node = SLIST_pop_##T(&list->head); \
+    if (node != NULL) \
+    { \
+        list->count--; \
+        if (list->head == NULL) \
+        { \
+            list->tail = NULL; \
+        } \
+    } \
+    SLIST_VALIDATE_BOUNDED(T, MAX, list); \
+    return node; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_BOUNDED_FUNC(add, T, MAX)(SLIST_BOUNDED(T, MAX)* list, SLIST_NODE(T)* node) \
+{ \
+    SLIST_NODE(T)* dropped = NULL; \
+    SLIST_VALIDATE_BOUNDED(T, MAX, list); \
+    for (SLIST_NODE(T)* curr = list->head; curr != NULL; curr = curr->next) \
+    { \
+        if (curr == node) \
+        { \
+            return NULL; \
+        } \
+    } \
+    if (list->count >= (MAX)) \
+    { \
+        if (list->policy == SLIST_DROP_NEW) \
+        { \
+            return node; \
+        } \
+        dropped = SLIST_BOUNDED_FUNC(pop, T, MAX)(list); \
+    } \
+    node->next = NULL; \
+    if (list->tail == NULL) \
+    { \
+        list->head = node; \
+    } \
+    else \
+    { \
+        list->tail->next = node; \
+    } \
+    list->tail = node; \
+    list->count++; \
+    SLIST_VALIDATE_BOUNDED(T, MAX, list); \
+    return dropped; \
+}
+
+#define SLIST_DECLARE_BOUNDED_REORDER_WITH_STORAGE(T, MAX, storage_) \
+storage_ void SLIST_BOUNDED_FUNC(reverse, T, MAX)(SLIST_BOUNDED(T, MAX)* list); \
+storage_ void SLIST_BOUNDED_FUNC(rotate, T, MAX)(SLIST_BOUNDED(T, MAX)* list, size_t k); \
+storage_ SLIST_NODE(T)* SLIST_BOUNDED_FUNC(split_at, T, MAX)(SLIST_BOUNDED(T, MAX)* list, size_t k)
+
+#define SLIST_DEFINE_BOUNDED_REORDER_WITH_STORAGE(T, MAX, storage_) \
+storage_ void SLIST_BOUNDED_FUNC(reverse, T, MAX)(SLIST_BOUNDED(T, MAX)* list) \
+{ \
+    SLIST_NODE(T)* reversed = NULL; \
+    SLIST_NODE(T)* node = list->head; \
+    list->tail = node; \
+    while (node != NULL) \
+    { \
+        SLIST_NODE(T)* next = node->next; \
+        node->next = reversed; \
+        reversed = node; \
+        node = next; \
+    } \
+    list->head = reversed; \
+    SLIST_VALIDATE_BOUNDED(T, MAX, list); \
+} \
+\
+/* The count is known, so only the k mod count first nodes are walked */ \
+storage_ void SLIST_BOUNDED_FUNC(rotate, T, MAX)(SLIST_BOUNDED(T, MAX)* list, size_t k) \
+{ \
+    SLIST_NODE(T)* last = list->head; \
+    if (list->count == 0 || (k %= list->count) == 0) \
+    { \
+        return; \
+    } \
+    while (--k != 0) \
+    { \
+        last = last->next; \
+    } \
+    list->tail->next = list->head; \
+    list->head = last->next; \
+    last->next = NULL; \
+    list->tail = last; \
+    SLIST_VALIDATE_BOUNDED(T, MAX, list); \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_BOUNDED_FUNC(split_at, T, MAX)(SLIST_BOUNDED(T, MAX)* list, size_t k) \
+{ \
+    SLIST_NODE(T)* last = list->head; \
+    SLIST_NODE(T)* rest; \
+    if (k >= list->count) \
+    { \
+        return NULL; \
+    } \
+    list->count = k; \
+    if (k == 0) \
+    { \
+        list->head = NULL; \
+        list->tail = NULL; \
+        return last; \
+    } \
+    while (--k != 0) \
+    { \
+        last = last->next; \
+    } \
+    rest = last->next; \
+    last->next = NULL; \
+    list->tail = last; \
+    SLIST_VALIDATE_BOUNDED(T, MAX, list); \
+    SLIST_VALIDATE_LIST(T, rest); \
+    return rest; \
+}
+
+#define SLIST_DECLARE_COUNTED_WITH_STORAGE(T, storage_) \
+SLIST_COUNTED(T) { \
+    SLIST_NODE(T)* head; \
+    size_t count; \
+}; \
+SLIST_DECLARE_COUNTED_VALIDATION(T, storage_) \
+storage_ SLIST_MAYBE_UNUSED int SLIST_counted_add_##T(SLIST_COUNTED(T)* list, SLIST_NODE(T)* node); \
+storage_ SLIST_MAYBE_UNUSED SLIST_NODE(T)* SLIST_counted_pop_##T(SLIST_COUNTED(T)* list); \
+storage_ SLIST_MAYBE_UNUSED int SLIST_counted_remove_##T(SLIST_COUNTED(T)* list, SLIST_NODE(T)* node); \
+storage_ SLIST_MAYBE_UNUSED void SLIST_counted_splice_##T(SLIST_COUNTED(T)* list, SLIST_COUNTED(T)* other)
+
+#define SLIST_DEFINE_COUNTED_WITH_STORAGE(T, storage_) \
+SLIST_DEFINE_COUNTED_VALIDATION(T, storage_) \
+storage_ int SLIST_counted_add_##T(SLIST_COUNTED(T)* list, SLIST_NODE(T)* node) \
+{ \
+    SLIST_VALIDATE_COUNTED(T, list); \
+    if (!SLIST_add_##T(&list->head, node)) \
+    { \
+        return 0; \
+    } \
+    list->count++; \
+    SLIST_VALIDATE_COUNTED(T, list); \
+    return 1; \
+} \
+\
+storage_ SLIST_NODE(T)* SLIST_counted_pop_##T(SLIST_COUNTED(T)* list) \
+{ \
+    SLIST_NODE(T)* node = SLIST_pop_##T(&list->head); \
+    if (node != NULL) \
+    { \
+        list->count--; \
+    } \
+    SLIST_VALIDATE_COUNTED(T, list); \
+    return node; \
+} \
+\
+storage_ int SLIST_counted_remove_##T(SLIST_COUNTED(T)* list, SLIST_NODE(T)* node) \
+{ \
+    SLIST_NODE(T)* previous = NULL; \
+    SLIST_NODE(T)* curr; \
+    for (curr = list->head; curr != NULL && curr != node; curr = curr->next) \
+    { \
+        previous = curr; \
+    } \
+    if (curr == NULL) \
+    { \
+        return 0; \
+    } \
+    if (previous == NULL) \
+    { \
+        list->head = node->next; \
+    } \
+    else \
+    { \
+        previous->next = node->next; \
+    } \
+    node->next = NULL; \
+    list->count--; \
+    SLIST_VALIDATE_COUNTED(T, list); \
+    return 1; \
+} \
+\
+storage_ void SLIST_counted_splice_##T(SLIST_COUNTED(T)* list, SLIST_COUNTED(T)* other) \
+{ \
+    SLIST_NODE(T)* tail = list->head; \
+    if (other->head == NULL || other == list) \
+    { \
+        return; \
+    } \
+    if (tail == NULL) \
+    { \
+        list->head = other->head; \
+    } \
+    else \
+    { \
+        while (tail->next != NULL) \
+        { \
+            tail = tail->next; \
+        } \
+        tail->next = other->head; \
+    } \
+    list->count += other->count; \
+    other->head = NULL; \
+    other->count = 0; \
+    SLIST_VALIDATE_COUNTED(T, list); \
 }
 
 #endif /* SLIST_TEMPLATE_H_ */
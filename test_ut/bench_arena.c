@@ -0,0 +1,178 @@
+/**
+ * Node allocation benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -I.. -o bench_arena bench_arena.c
+ *	./bench_arena [-n nodes] [--chunk bytes]
+ *
+ * Builds a list of n dynamically allocated nodes, walks it and releases it,
+ * reporting ns per node of every phase as JSON for each allocator:
+ *
+ * - malloc: one malloc per node, one free per node
+ * - malloc_fragmented: same, interleaved with other allocations of random
+ *   size that stay alive, as in a long running process
+ * - arena: SLIST_ARENA_ALLOC from malloc chunks, one destroy at the end
+ * - arena_hugepages: same with mmap chunks advised with MADV_HUGEPAGE
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_arena_template.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+	uint64_t key;
+	uint8_t payload[40];
+} sItem;
+
+SLIST_DECLARE_STATIC(sItem);
+SLIST_DEFINE_STATIC(sItem);
+
+enum {
+	ALLOCATOR_MALLOC,
+	ALLOCATOR_MALLOC_FRAGMENTED,
+	ALLOCATOR_ARENA,
+	ALLOCATOR_ARENA_HUGEPAGES,
+	ALLOCATORS
+};
+
+static const char* const allocatorNames[ALLOCATORS] = {
+	"malloc", "malloc_fragmented", "arena", "arena_hugepages"
+};
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t random_state = 88172645463325252ull;
+
+static uint64_t random_next(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return random_state;
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [-n nodes] [--chunk bytes]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = 1000000;
+	size_t chunk = (size_t)2u << 20;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			n = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--chunk") == 0 && i + 1 < argc)
+		{
+			chunk = strtoul(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (n == 0 || chunk == 0)
+	{
+		usage(argv[0]);
+	}
+
+	void** noise = calloc(n, sizeof(void*));
+	if (noise == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	printf("{\"benchmark\": \"arena\", \"n\": %lu, \"chunk\": %lu, \"results\": [",
+		(unsigned long)n, (unsigned long)chunk);
+	for (int allocator = 0; allocator < ALLOCATORS; allocator++)
+	{
+		SLIST_CREATE_ARENA(arena, chunk, (allocator == ALLOCATOR_ARENA_HUGEPAGES) ? SLIST_ARENA_HUGEPAGES : 0);
+		SLIST_NODE(sItem)* head = NULL;
+		SLIST_NODE(sItem)** tail = &head;
+
+		// Appending by hand, SLIST_ADD_NODE would walk the whole list every time
+		uint64_t start = now_ns();
+		for (size_t i = 0; i < n; i++)
+		{
+			SLIST_NODE(sItem)* node;
+			if (allocator == ALLOCATOR_MALLOC || allocator == ALLOCATOR_MALLOC_FRAGMENTED)
+			{
+				if (allocator == ALLOCATOR_MALLOC_FRAGMENTED)
+				{
+					noise[i] = malloc(16 + random_next() % 256);
+				}
+				node = malloc(sizeof(*node));
+			}
+			else
+			{
+				node = SLIST_ARENA_ALLOC(sItem, arena);
+			}
+			if (node == NULL)
+			{
+				fprintf(stderr, "out of memory\n");
+				return 1;
+			}
+			node->data.key = i;
+			node->next = NULL;
+			*tail = node;
+			tail = &node->next;
+		}
+		uint64_t allocated = now_ns();
+
+		uint64_t sum = 0;
+		SLIST_FOR_EACH_NODE_PTR(sItem, head, node)
+		{
+			sum += node->data.key;
+		}
+		uint64_t walked = now_ns();
+
+		if (allocator == ALLOCATOR_MALLOC || allocator == ALLOCATOR_MALLOC_FRAGMENTED)
+		{
+			while (head != NULL)
+			{
+				SLIST_NODE(sItem)* next = head->next;
+				free(head);
+				head = next;
+			}
+		}
+		else
+		{
+			head = NULL;
+			SLIST_ARENA_DESTROY(arena);
+		}
+		uint64_t released = now_ns();
+
+		if (allocator == ALLOCATOR_MALLOC_FRAGMENTED)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				free(noise[i]);
+			}
+		}
+
+		printf("%s\n    {\"allocator\": \"%s\", \"alloc_ns\": %.3f, \"walk_ns\": %.3f, "
+			"\"release_ns\": %.3f, \"check\": %llu}",
+			allocator == 0 ? "" : ",", allocatorNames[allocator],
+			(double)(allocated - start) / (double)n, (double)(walked - allocated) / (double)n,
+			(double)(released - walked) / (double)n, (unsigned long long)sum);
+	}
+	printf("\n]}\n");
+
+	free(noise);
+	return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * Awaitable queue benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	g++ -O2 -std=c++20 -pthread -I.. -o bench_async bench_async.cpp
+ *	./bench_async [--ops operations]
+ *
+ * A consumer waits for every node a producer hands over, as a coroutine
+ * suspended on SLIST_ASYNC_QUEUE and resumed by the push itself (coroutine),
+ * and as a thread blocked on a condition variable, the same queue being
+ * guarded by a mutex (condition_variable). Throughput (ops/s) and ns per
+ * hand over are printed as JSON.
+ */
+
+#include "../slist_async_template.h"
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <time.h>
+
+SLIST_DECLARE_STATIC(uint64_t);
+SLIST_DEFINE_STATIC(uint64_t);
+SLIST_ASYNC_DECLARE(uint64_t);
+
+struct sTask
+{
+	struct promise_type
+	{
+		sTask get_return_object() { return sTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+	std::coroutine_handle<promise_type> handle;
+};
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t checksum;
+
+static sTask consume(SLIST_ASYNC_QUEUE(uint64_t)& queue, size_t ops)
+{
+	for (size_t i = 0; i < ops; i++)
+	{
+		SLIST_NODE(uint64_t)* node = co_await SLIST_ASYNC_POP(uint64_t, queue);
+		checksum += node->data;
+	}
+}
+
+static uint64_t run_coroutine(SLIST_NODE(uint64_t)* nodes, size_t ops)
+{
+	SLIST_ASYNC_QUEUE(uint64_t) queue;
+	uint64_t begin = now_ns();
+	sTask consumer = consume(queue, ops);
+	for (size_t i = 0; i < ops; i++)
+	{
+		SLIST_ASYNC_PUSH(uint64_t, queue, nodes[i]);
+	}
+	uint64_t elapsed = now_ns() - begin;
+	if (!consumer.handle.done())
+	{
+		fprintf(stderr, "consumer not done\n");
+		exit(1);
+	}
+	consumer.handle.destroy();
+	return elapsed;
+}
+
+static uint64_t run_condition_variable(SLIST_NODE(uint64_t)* nodes, size_t ops)
+{
+	SLIST_ASYNC_QUEUE(uint64_t) queue;
+	std::mutex lock;
+	std::condition_variable available;
+	uint64_t begin = now_ns();
+	std::thread consumer([&]
+	{
+		for (size_t i = 0; i < ops; i++)
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			SLIST_NODE(uint64_t)* node;
+			available.wait(guard, [&] { return (node = SLIST_ASYNC_TRY_POP(uint64_t, queue)) != NULL; });
+			guard.unlock();
+			checksum += node->data;
+		}
+	});
+	for (size_t i = 0; i < ops; i++)
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			SLIST_ASYNC_PUSH(uint64_t, queue, nodes[i]);
+		}
+		available.notify_one();
+	}
+	consumer.join();
+	return now_ns() - begin;
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [--ops operations]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t ops = 1000000;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+		{
+			ops = strtoul(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (ops == 0)
+	{
+		usage(argv[0]);
+	}
+
+	SLIST_NODE(uint64_t)* nodes = new SLIST_NODE(uint64_t)[ops];
+	for (size_t i = 0; i < ops; i++)
+	{
+		nodes[i].data = i;
+		nodes[i].next = NULL;
+	}
+
+	uint64_t coroutineNs = run_coroutine(nodes, ops);
+	uint64_t conditionNs = run_condition_variable(nodes, ops);
+	printf("{\"benchmark\": \"async\", \"ops\": %lu, \"results\": [", (unsigned long)ops);
+	printf("\n    {\"wait\": \"coroutine\", \"ops_per_s\": %.0f, \"ns_per_op\": %.3f},",
+		(double)ops * 1e9 / (double)coroutineNs, (double)coroutineNs / (double)ops);
+	printf("\n    {\"wait\": \"condition_variable\", \"ops_per_s\": %.0f, \"ns_per_op\": %.3f}",
+		(double)ops * 1e9 / (double)conditionNs, (double)conditionNs / (double)ops);
+	printf("\n], \"checksum\": %lu}\n", (unsigned long)checksum);
+
+	delete[] nodes;
+	return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * Batch threshold benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -I.. -o bench_batch bench_batch.c
+ *	./bench_batch [-n items] [--interval-ns ns] [--delay-ns ns]
+ *
+ * Items arrive every interval (busy waited) and are queued in a batch. Every
+ * flush writes the whole batch to /dev/null with a single system call, which
+ * stands for the fixed cost a real consumer pays per batch. For several count
+ * thresholds it reports throughput and the latency from enqueue to flush
+ * (mean and p99) as JSON, showing the latency versus throughput trade-off.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_batch_template.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+	uint64_t enqueued;
+	uint8_t payload[56];
+} sItem;
+
+SLIST_DECLARE_STATIC(sItem);
+SLIST_DEFINE_STATIC(sItem);
+SLIST_BATCH_DECLARE_STATIC(sItem);
+SLIST_BATCH_DEFINE_STATIC(sItem);
+
+#define MAX_BATCH 1024u
+
+typedef struct {
+	int fd;
+	uint64_t* latencies;
+	size_t done;
+	uint8_t buffer[MAX_BATCH * sizeof(sItem)];
+} sConsumer;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void consume(SLIST_NODE(sItem)* batch, size_t count, void* context)
+{
+	sConsumer* consumer = context;
+	size_t used = 0;
+	(void)count;
+	SLIST_FOR_EACH_NODE_PTR(sItem, batch, node)
+	{
+		memcpy(&consumer->buffer[used], &node->data, sizeof(node->data));
+		used += sizeof(node->data);
+	}
+	if (write(consumer->fd, consumer->buffer, used) < 0)
+	{
+		perror("write");
+		exit(1);
+	}
+	uint64_t flushed = now_ns();
+	SLIST_FOR_EACH_NODE_PTR(sItem, batch, node)
+	{
+		consumer->latencies[consumer->done++] = flushed - node->data.enqueued;
+	}
+}
+
+static int compare_u64(const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [-n items] [--interval-ns ns] [--delay-ns ns]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = 100000;
+	uint64_t interval = 200;
+	uint64_t delay = 50000;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			n = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--interval-ns") == 0 && i + 1 < argc)
+		{
+			interval = strtoull(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--delay-ns") == 0 && i + 1 < argc)
+		{
+			delay = strtoull(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (n == 0)
+	{
+		usage(argv[0]);
+	}
+
+	static sConsumer consumer;
+	consumer.fd = open("/dev/null", O_WRONLY);
+	consumer.latencies = calloc(n, sizeof(uint64_t));
+	SLIST_NODE(sItem)* items = calloc(n, sizeof(*items));
+	if (consumer.fd < 0 || consumer.latencies == NULL || items == NULL)
+	{
+		fprintf(stderr, "setup failed\n");
+		return 1;
+	}
+
+	static const size_t thresholds[] = { 1, 4, 16, 64, 256, MAX_BATCH };
+	printf("{\"benchmark\": \"batch\", \"interval_ns\": %llu, \"delay_ns\": %llu, \"results\": [",
+		(unsigned long long)interval, (unsigned long long)delay);
+	for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++)
+	{
+		SLIST_CREATE_BATCH(sItem, batch, thresholds[t], 0, delay, consume, &consumer);
+		consumer.done = 0;
+		uint64_t start = now_ns();
+		uint64_t next = start;
+		for (size_t i = 0; i < n; i++)
+		{
+			uint64_t now;
+			while ((now = now_ns()) < next)
+			{
+				SLIST_BATCH_POLL(sItem, batch, now);
+			}
+			next += interval;
+			items[i].data.enqueued = now;
+			SLIST_BATCH_ADD(sItem, batch, items[i], sizeof(sItem), now);
+		}
+		SLIST_BATCH_FLUSH(sItem, batch);
+		uint64_t elapsed = now_ns() - start;
+
+		uint64_t sum = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			sum += consumer.latencies[i];
+		}
+		qsort(consumer.latencies, n, sizeof(uint64_t), compare_u64);
+		printf("%s\n    {\"threshold\": %lu, \"items_per_s\": %.0f, "
+			"\"latency_mean_ns\": %.0f, \"latency_p99_ns\": %llu}",
+			t == 0 ? "" : ",", (unsigned long)thresholds[t],
+			(double)n * 1e9 / (double)elapsed, (double)sum / (double)n,
+			(unsigned long long)consumer.latencies[(n * 99) / 100]);
+	}
+	printf("\n]}\n");
+
+	close(consumer.fd);
+	free(consumer.latencies);
+	free(items);
+	return 0;
+}
@@ -0,0 +1,431 @@
+/**
+ * Event loop benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -I.. -o bench_event_loop bench_event_loop.c
+ *	./bench_event_loop [--seconds s] [--yields n] [--timers n] [--pipes n]
+ *		[--tokens n] [--horizon us]
+ *
+ * A small single-threaded runtime built only on the list templates, shaped
+ * like a production event loop:
+ *
+ * - ready: FIFO of runnable tasks (bounded list)
+ * - timers: tasks waiting for a deadline (pairing heap), woken through a
+ *   timerfd armed to the earliest one whenever the loop would block
+ * - watches: fds registered in epoll (list), each waking a task
+ *
+ * and a mixed workload over it for the given time:
+ *
+ * - yield tasks re-post themselves, exercising the ready queue alone
+ * - timer tasks re-arm themselves a random delay up to horizon us later
+ * - pipe tasks pass tokens around a ring of pipes, each read waking the next
+ *
+ * Callbacks per second (total and per kind) and scheduling latency, from a
+ * task becoming runnable (post, deadline or epoll wake up) to its callback,
+ * are printed as JSON.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_heap_template.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Runtime
+ */
+
+#define READY_MAX 4096
+#define EVENTS_MAX 64
+#define LATENCY_SAMPLES (1u << 20)
+
+struct sLoop;
+SLIST_HEAP_NODE(sTask);
+
+typedef enum {
+	TASK_YIELD,
+	TASK_TIMER,
+	TASK_PIPE,
+	TASK_KINDS
+} eTaskKind;
+
+typedef struct {
+	void (*run)(struct sLoop* loop, SLIST_HEAP_NODE(sTask)* task);
+	eTaskKind kind;
+	uint64_t deadline;
+	uint64_t readyAt;
+	int in;
+	int out;
+} sTask;
+
+typedef struct {
+	int fd;
+	SLIST_HEAP_NODE(sTask)* task;
+} sWatch;
+
+#define TASK_LESS(a, b) ((a)->deadline < (b)->deadline)
+
+SLIST_DECLARE_STATIC(sTask);
+SLIST_DEFINE_STATIC(sTask);
+SLIST_HEAP_DECLARE_STATIC(sTask);
+SLIST_HEAP_DEFINE_STATIC(sTask, TASK_LESS);
+SLIST_DECLARE_BOUNDED_STATIC(sTask, READY_MAX);
+SLIST_DEFINE_BOUNDED_STATIC(sTask, READY_MAX);
+SLIST_DECLARE_STATIC(sWatch);
+SLIST_DEFINE_STATIC(sWatch);
+
+typedef struct sLoop {
+	int epoll;
+	int timer;
+	uint64_t timerArmed;
+	SLIST_BOUNDED(sTask, READY_MAX) ready;
+	SLIST_HEAP(sTask) timers;
+	SLIST_NODE(sWatch)* watches;
+	uint64_t callbacks[TASK_KINDS];
+	uint64_t* latencies;
+	uint64_t latencyCount;
+} sLoop;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void fail(const char* what)
+{
+	perror(what);
+	exit(1);
+}
+
+static void loop_init(sLoop* loop)
+{
+	struct epoll_event event;
+	memset(loop, 0, sizeof(*loop));
+	loop->ready.policy = SLIST_DROP_NEW;
+	loop->epoll = epoll_create1(0);
+	loop->timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+	loop->latencies = malloc(LATENCY_SAMPLES * sizeof(uint64_t));
+	if (loop->epoll < 0 || loop->timer < 0 || loop->latencies == NULL)
+	{
+		fail("loop_init");
+	}
+	// The timerfd is the only registration without a watch
+	event.events = EPOLLIN;
+	event.data.ptr = NULL;
+	if (epoll_ctl(loop->epoll, EPOLL_CTL_ADD, loop->timer, &event) != 0)
+	{
+		fail("epoll_ctl");
+	}
+}
+
+static void loop_post(sLoop* loop, SLIST_HEAP_NODE(sTask)* task, uint64_t readyAt)
+{
+	task->link.data.readyAt = readyAt;
+	if (SLIST_BOUNDED_ADD_PTR(sTask, READY_MAX, loop->ready, &task->link) != NULL)
+	{
+		fprintf(stderr, "ready queue full\n");
+		exit(1);
+	}
+}
+
+static void loop_after(sLoop* loop, SLIST_HEAP_NODE(sTask)* task, uint64_t delay)
+{
+	task->link.data.deadline = now_ns() + delay;
+	SLIST_HEAP_INSERT_PTR(sTask, loop->timers, task);
+}
+
+static void loop_watch(sLoop* loop, SLIST_NODE(sWatch)* watch, int fd, SLIST_HEAP_NODE(sTask)* task)
+{
+	struct epoll_event event;
+	watch->data.fd = fd;
+	watch->data.task = task;
+	event.events = EPOLLIN;
+	event.data.ptr = watch;
+	if (epoll_ctl(loop->epoll, EPOLL_CTL_ADD, fd, &event) != 0)
+	{
+		fail("epoll_ctl");
+	}
+	SLIST_ADD_NODE_PTR(sWatch, loop->watches, watch);
+}
+
+static void loop_destroy(sLoop* loop)
+{
+	SLIST_NODE(sWatch)* watch;
+	while ((watch = SLIST_POP_NODE(sWatch, loop->watches)) != NULL)
+	{
+		epoll_ctl(loop->epoll, EPOLL_CTL_DEL, watch->data.fd, NULL);
+	}
+	close(loop->timer);
+	close(loop->epoll);
+	free(loop->latencies);
+}
+
+static void loop_expire(sLoop* loop, uint64_t now)
+{
+	SLIST_HEAP_NODE(sTask)* first;
+	while ((first = SLIST_HEAP_PEEK(loop->timers)) != NULL && first->link.data.deadline <= now)
+	{
+		SLIST_HEAP_POP_MIN(sTask, loop->timers);
+		loop_post(loop, first, first->link.data.deadline);
+	}
+}
+
+static int loop_timeout(sLoop* loop)
+{
+	SLIST_HEAP_NODE(sTask)* first = SLIST_HEAP_PEEK(loop->timers);
+	if (SLIST_BOUNDED_COUNT(loop->ready) > 0)
+	{
+		return 0;
+	}
+	if (first != NULL && first->link.data.deadline != loop->timerArmed)
+	{
+		struct itimerspec spec;
+		memset(&spec, 0, sizeof(spec));
+		spec.it_value.tv_sec = (time_t)(first->link.data.deadline / 1000000000u);
+		spec.it_value.tv_nsec = (long)(first->link.data.deadline % 1000000000u);
+		timerfd_settime(loop->timer, TFD_TIMER_ABSTIME, &spec, NULL);
+		loop->timerArmed = first->link.data.deadline;
+	}
+	return -1;
+}
+
+static void loop_poll(sLoop* loop, int timeout)
+{
+	struct epoll_event events[EVENTS_MAX];
+	int count = epoll_wait(loop->epoll, events, EVENTS_MAX, timeout);
+	if (count < 0 && errno != EINTR)
+	{
+		fail("epoll_wait");
+	}
+	uint64_t now = now_ns();
+	for (int i = 0; i < count; i++)
+	{
+		SLIST_NODE(sWatch)* watch = events[i].data.ptr;
+		if (watch == NULL)
+		{
+			uint64_t expirations;
+			if (read(loop->timer, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+			{
+				fail("read");
+			}
+			loop->timerArmed = 0;
+		}
+		else
+		{
+			// Already runnable tasks stay where they are (duplicate add)
+			loop_post(loop, watch->data.task, now);
+		}
+	}
+	loop_expire(loop, now);
+}
+
+static void loop_run_ready(sLoop* loop)
+{
+	// Tasks posted by the callbacks wait for the next iteration
+	size_t runnable = SLIST_BOUNDED_COUNT(loop->ready);
+	while (runnable-- > 0)
+	{
+		SLIST_HEAP_NODE(sTask)* task = (SLIST_HEAP_NODE(sTask)*)SLIST_BOUNDED_POP(sTask, READY_MAX, loop->ready);
+		uint64_t now = now_ns();
+		loop->latencies[loop->latencyCount++ % LATENCY_SAMPLES] = now - task->link.data.readyAt;
+		loop->callbacks[task->link.data.kind]++;
+		task->link.data.run(loop, task);
+	}
+}
+
+static void loop_run(sLoop* loop, uint64_t until)
+{
+	while (now_ns() < until)
+	{
+		loop_poll(loop, loop_timeout(loop));
+		loop_run_ready(loop);
+	}
+}
+
+/*
+ * Workload
+ */
+
+static uint64_t random_state = 88172645463325252ull;
+static uint64_t horizonNs = 1000000;
+
+static uint64_t random_delay(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return 1 + random_state % horizonNs;
+}
+
+static void yield_run(sLoop* loop, SLIST_HEAP_NODE(sTask)* task)
+{
+	loop_post(loop, task, now_ns());
+}
+
+static void timer_run(sLoop* loop, SLIST_HEAP_NODE(sTask)* task)
+{
+	loop_after(loop, task, random_delay());
+}
+
+static void pipe_run(sLoop* loop, SLIST_HEAP_NODE(sTask)* task)
+{
+	char token;
+	(void)loop;
+	if (read(task->link.data.in, &token, 1) == 1 && write(task->link.data.out, &token, 1) != 1)
+	{
+		fail("write");
+	}
+}
+
+static int compare_u64(const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [--seconds s] [--yields n] [--timers n] [--pipes n] [--tokens n] [--horizon us]\n",
+		program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	double seconds = 1.0;
+	size_t yields = 16;
+	size_t timers = 256;
+	size_t pipes = 64;
+	size_t tokens = 16;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+		{
+			seconds = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--yields") == 0 && i + 1 < argc)
+		{
+			yields = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--timers") == 0 && i + 1 < argc)
+		{
+			timers = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--pipes") == 0 && i + 1 < argc)
+		{
+			pipes = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--tokens") == 0 && i + 1 < argc)
+		{
+			tokens = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc)
+		{
+			horizonNs = strtoull(argv[++i], NULL, 0) * 1000u;
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	size_t tasks = yields + timers + pipes;
+	if (seconds <= 0 || tasks == 0 || tasks > READY_MAX || horizonNs == 0 || (pipes > 0 && tokens > pipes))
+	{
+		usage(argv[0]);
+	}
+
+	sLoop loop;
+	loop_init(&loop);
+	SLIST_HEAP_NODE(sTask)* nodes = calloc(tasks, sizeof(*nodes));
+	SLIST_NODE(sWatch)* watches = calloc(pipes + 1, sizeof(*watches));
+	int* fds = malloc(2 * (pipes + 1) * sizeof(int));
+	if (nodes == NULL || watches == NULL || fds == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < pipes; i++)
+	{
+		if (pipe(&fds[2 * i]) != 0)
+		{
+			fail("pipe");
+		}
+	}
+	for (size_t i = 0; i < tasks; i++)
+	{
+		sTask* task = &nodes[i].link.data;
+		if (i < yields)
+		{
+			task->kind = TASK_YIELD;
+			task->run = yield_run;
+			loop_post(&loop, &nodes[i], now_ns());
+		}
+		else if (i < yields + timers)
+		{
+			task->kind = TASK_TIMER;
+			task->run = timer_run;
+			loop_after(&loop, &nodes[i], random_delay());
+		}
+		else
+		{
+			// Pipe task p reads pipe p and writes pipe p + 1, closing the ring
+			size_t p = i - yields - timers;
+			task->kind = TASK_PIPE;
+			task->run = pipe_run;
+			task->in = fds[2 * p];
+			task->out = fds[2 * ((p + 1) % pipes) + 1];
+			loop_watch(&loop, &watches[p], task->in, &nodes[i]);
+		}
+	}
+	for (size_t i = 0; i < tokens && pipes > 0; i++)
+	{
+		if (write(fds[2 * (i * pipes / tokens) + 1], "t", 1) != 1)
+		{
+			fail("write");
+		}
+	}
+
+	uint64_t begin = now_ns();
+	loop_run(&loop, begin + (uint64_t)(seconds * 1e9));
+	double elapsed = (double)(now_ns() - begin) / 1e9;
+
+	uint64_t total = 0;
+	for (int kind = 0; kind < TASK_KINDS; kind++)
+	{
+		total += loop.callbacks[kind];
+	}
+	size_t samples = loop.latencyCount < LATENCY_SAMPLES ? (size_t)loop.latencyCount : LATENCY_SAMPLES;
+	qsort(loop.latencies, samples, sizeof(uint64_t), compare_u64);
+	printf("{\"benchmark\": \"event_loop\", \"seconds\": %.3f, \"yields\": %lu, \"timers\": %lu, \"pipes\": %lu, "
+		"\"tokens\": %lu, \"horizon_us\": %lu, \"results\": [",
+		elapsed, (unsigned long)yields, (unsigned long)timers, (unsigned long)pipes, (unsigned long)tokens,
+		(unsigned long)(horizonNs / 1000u));
+	printf("\n    {\"callbacks_per_s\": %.0f, \"yield_per_s\": %.0f, \"timer_per_s\": %.0f, \"pipe_per_s\": %.0f, "
+		"\"latency_p50_ns\": %lu, \"latency_p99_ns\": %lu, \"latency_max_ns\": %lu}",
+		(double)total / elapsed, (double)loop.callbacks[TASK_YIELD] / elapsed,
+		(double)loop.callbacks[TASK_TIMER] / elapsed, (double)loop.callbacks[TASK_PIPE] / elapsed,
+		samples ? (unsigned long)loop.latencies[samples / 2] : 0ul,
+		samples ? (unsigned long)loop.latencies[samples - 1 - samples / 100] : 0ul,
+		samples ? (unsigned long)loop.latencies[samples - 1] : 0ul);
+	printf("\n]}\n");
+
+	loop_destroy(&loop);
+	for (size_t i = 0; i < 2 * pipes; i++)
+	{
+		close(fds[i]);
+	}
+	free(nodes);
+	free(watches);
+	free(fds);
+	return 0;
+}
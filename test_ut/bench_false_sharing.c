@@ -0,0 +1,141 @@
+/**
+ * False sharing benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -pthread -I.. -o bench_false_sharing bench_false_sharing.c
+ *	./bench_false_sharing [-t threads] [--ops operations]
+ *
+ * Every thread adds and pops a node over its own list, so no data is shared,
+ * only the cache lines holding the list heads. With the heads in a plain
+ * array (packed) every write invalidates the line in the other cores, with
+ * SLIST_PADDED_LIST (padded) each head has its own line. Threads are pinned
+ * to different CPUs when there are enough of them. Every thread times its own
+ * loop, and the slowest one is reported. Results are printed as JSON in ns per
+ * add+pop, the difference being the false sharing penalty.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_template.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+SLIST_DECLARE_STATIC(uint64_t);
+SLIST_DEFINE_STATIC(uint64_t);
+
+#define MAX_THREADS 64
+
+static SLIST_NODE(uint64_t)* packedHeads[MAX_THREADS];
+static SLIST_PADDED_LIST(uint64_t) paddedHeads[MAX_THREADS];
+
+typedef struct {
+	SLIST_NODE(uint64_t)** head;
+	size_t ops;
+	int cpu;
+	pthread_barrier_t* start;
+	uint64_t elapsed;
+} sWorker;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void* work(void* argument)
+{
+	sWorker* worker = argument;
+	SLIST_NODE(uint64_t) node;
+	node.data = 0;
+	if (worker->cpu >= 0)
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(worker->cpu, &cpus);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+	}
+	pthread_barrier_wait(worker->start);
+	uint64_t begin = now_ns();
+	for (size_t i = 0; i < worker->ops; i++)
+	{
+		SLIST_ADD_NODE_PTR(uint64_t, *worker->head, &node);
+		SLIST_POP_NODE(uint64_t, *worker->head)->data++;
+	}
+	worker->elapsed = now_ns() - begin;
+	return NULL;
+}
+
+static double run(int threads, size_t ops, int padded)
+{
+	pthread_t ids[MAX_THREADS];
+	sWorker workers[MAX_THREADS];
+	pthread_barrier_t start;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	pthread_barrier_init(&start, NULL, (unsigned)threads + 1);
+	for (int i = 0; i < threads; i++)
+	{
+		workers[i].head = padded ? &SLIST_PADDED_HEAD(paddedHeads[i]) : &packedHeads[i];
+		workers[i].ops = ops;
+		workers[i].cpu = (threads <= cpus) ? i : -1;
+		workers[i].start = &start;
+		pthread_create(&ids[i], NULL, work, &workers[i]);
+	}
+	pthread_barrier_wait(&start);
+	uint64_t elapsed = 0;
+	for (int i = 0; i < threads; i++)
+	{
+		pthread_join(ids[i], NULL);
+		if (workers[i].elapsed > elapsed)
+		{
+			elapsed = workers[i].elapsed;
+		}
+	}
+	pthread_barrier_destroy(&start);
+	return (double)elapsed / (double)ops;
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [-t threads] [--ops operations]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	int threads = 4;
+	size_t ops = 10000000;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+		{
+			threads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+		{
+			ops = strtoul(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (threads <= 0 || threads > MAX_THREADS || ops == 0)
+	{
+		usage(argv[0]);
+	}
+
+	printf("{\"benchmark\": \"false_sharing\", \"threads\": %d, \"ops\": %lu, \"cpus\": %ld, \"results\": [",
+		threads, (unsigned long)ops, sysconf(_SC_NPROCESSORS_ONLN));
+	printf("\n    {\"heads\": \"packed\", \"head_stride\": %lu, \"ns_per_op\": %.3f},",
+		(unsigned long)sizeof(packedHeads[0]), run(threads, ops, 0));
+	printf("\n    {\"heads\": \"padded\", \"head_stride\": %lu, \"ns_per_op\": %.3f}",
+		(unsigned long)sizeof(paddedHeads[0]), run(threads, ops, 1));
+	printf("\n]}\n");
+	return 0;
+}
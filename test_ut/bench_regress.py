@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+Benchmark regression tracker for slist_template.h
+
+Builds bench_slist.c, runs it several times and summarizes every
+(workload, layout, n) result as the median of ns_per_element with a
+distribution-free confidence interval (order statistics of the binomial).
+
+    ./bench_regress.py --save            # record a baseline
+    ./bench_regress.py                   # compare against it
+
+A result is flagged as a regression when its median is slower than the
+baseline median by more than --threshold AND the confidence intervals of
+both runs do not overlap. Any regression makes the exit status non-zero.
+If no baseline exists yet the current run is stored as the baseline.
+
+Baselines are machine specific, keep them out of version control.
+"""
+
+import argparse
+import json
+import math
+import os
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_BASELINE = os.path.join(HERE, "bench_baseline.json")
+DEFAULT_BINARY = os.path.join(HERE, "build", "bench_slist")
+
+
+def build(binary, cc):
+    os.makedirs(os.path.dirname(binary), exist_ok=True)
+    cmd = [cc, "-O2", "-std=c99", "-I" + os.path.join(HERE, ".."),
+           "-o", binary, os.path.join(HERE, "bench_slist.c")]
+    subprocess.run(cmd, check=True)
+
+
+def run(binary, args, repeats):
+    samples = {}
+    for _ in range(repeats):
+        out = subprocess.run([binary] + args, check=True,
+                             stdout=subprocess.PIPE, universal_newlines=True).stdout
+        for result in json.loads(out)["results"]:
+            key = "%s/%s/%d" % (result["workload"], result["layout"], result["n"])
+            samples.setdefault(key, []).append(result["ns_per_element"])
+    return samples
+
+
+def median_ci(values, confidence):
+    """Median and the order statistic interval covering it with the given confidence"""
+    values = sorted(values)
+    n = len(values)
+    mid = n // 2
+    median = values[mid] if n % 2 else (values[mid - 1] + values[mid]) / 2.0
+    # Largest k so that [x(k), x(n-k+1)] still covers the median with the
+    # requested confidence: P(k <= Binomial(n, 1/2) <= n-k)
+    alpha = 1.0 - confidence
+    k = 0
+    tail = 0.0
+    while k < mid:
+        tail += math.comb(n, k) / 2.0 ** n
+        if 2.0 * tail > alpha:
+            break
+        k += 1
+    low = values[k - 1] if k > 0 else values[0]
+    high = values[n - k] if k > 0 else values[-1]
+    return median, low, high
+
+
+def summarize(samples, confidence):
+    summary = {}
+    for key, values in samples.items():
+        median, low, high = median_ci(values, confidence)
+        summary[key] = {"median": median, "ci_low": low, "ci_high": high,
+                        "samples": values}
+    return summary
+
+
+def compare(baseline, current, threshold):
+    regressions = 0
+    print("%-32s %12s %12s %8s" % ("benchmark", "baseline", "current", "change"))
+    for key in sorted(current):
+        now = current[key]
+        before = baseline.get(key)
+        if before is None:
+            print("%-32s %12s %12.3f %8s" % (key, "-", now["median"], "new"))
+            continue
+        change = now["median"] / before["median"] - 1.0
+        slower = change > threshold and now["ci_low"] > before["ci_high"]
+        faster = change < -threshold and now["ci_high"] < before["ci_low"]
+        verdict = "REGRESSION" if slower else ("improved" if faster else "")
+        print("%-32s %12.3f %12.3f %+7.1f%% %s" % (key, before["median"], now["median"],
+                                                   100.0 * change, verdict))
+        regressions += slower
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE)
+    parser.add_argument("--save", action="store_true",
+                        help="store this run as the new baseline")
+    parser.add_argument("--repeats", type=int, default=11)
+    parser.add_argument("--confidence", type=float, default=0.95)
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown tolerated (default 5%%)")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"))
+    parser.add_argument("--binary", default=DEFAULT_BINARY)
+    parser.add_argument("bench_args", nargs=argparse.REMAINDER,
+                        help="arguments after -- are passed to bench_slist")
+    args = parser.parse_args()
+
+    bench_args = [a for a in args.bench_args if a != "--"]
+    build(args.binary, args.cc)
+    current = summarize(run(args.binary, bench_args, args.repeats), args.confidence)
+
+    if args.save or not os.path.exists(args.baseline):
+        with open(args.baseline, "w") as f:
+            json.dump({"args": bench_args, "results": current}, f, indent=2)
+        print("baseline stored in %s" % args.baseline)
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    if baseline.get("args", []) != bench_args:
+        print("warning: baseline recorded with arguments %s" % baseline.get("args"),
+              file=sys.stderr)
+    regressions = compare(baseline["results"], current, args.threshold)
+    if regressions:
+        print("%d benchmark(s) regressed" % regressions)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
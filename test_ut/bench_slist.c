@@ -0,0 +1,355 @@
+/**
+ * Benchmark harness to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -I.. -o bench_slist bench_slist.c
+ *	./bench_slist [-n elements] [--perf]
+ *
+ * Every workload is run over two layouts of the same node array: linked in
+ * array order (sequential) and linked in a random permutation (scattered),
+ * so that the cost of chasing pointers through memory becomes visible.
+ *
+ * Results are printed as JSON to stdout. With --perf, cycles, instructions,
+ * L1D and LLC read misses and branch misses are read through perf_event_open
+ * around each workload and reported both in total and per element. Counters
+ * not available in the host (virtual machines, perf_event_paranoid) are
+ * reported as null.
+ *
+ * bench_regress.py runs this harness repeatedly and compares the results
+ * against a stored baseline to catch performance regressions.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_template.h"
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+
+/*
+ * Hardware counters
+ */
+
+typedef struct {
+	const char* name;
+	uint32_t type;
+	uint64_t config;
+} sCounterSpec;
+
+#define CACHE_READ_MISS(cache_) \
+	((cache_) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const sCounterSpec counterSpecs[] = {
+	{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ "l1d_misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D) },
+	{ "llc_misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL) },
+	{ "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+#define COUNTERS (sizeof(counterSpecs) / sizeof(counterSpecs[0]))
+
+typedef struct {
+	int fd[COUNTERS];
+	uint64_t value[COUNTERS];
+} sCounters;
+
+static void counters_open(sCounters* counters)
+{
+	for (size_t i = 0; i < COUNTERS; i++)
+	{
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = counterSpecs[i].type;
+		attr.config = counterSpecs[i].config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		counters->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		if (counters->fd[i] < 0)
+		{
+			fprintf(stderr, "perf counter %s not available\n", counterSpecs[i].name);
+		}
+	}
+}
+
+static void counters_close(sCounters* counters)
+{
+	for (size_t i = 0; i < COUNTERS; i++)
+	{
+		if (counters->fd[i] >= 0)
+		{
+			close(counters->fd[i]);
+		}
+	}
+}
+
+static void counters_start(sCounters* counters)
+{
+	for (size_t i = 0; i < COUNTERS; i++)
+	{
+		if (counters->fd[i] >= 0)
+		{
+			ioctl(counters->fd[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(counters->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+}
+
+static void counters_stop(sCounters* counters)
+{
+	for (size_t i = 0; i < COUNTERS; i++)
+	{
+		counters->value[i] = 0;
+		if (counters->fd[i] >= 0)
+		{
+			ioctl(counters->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+			if (read(counters->fd[i], &counters->value[i], sizeof(uint64_t)) != sizeof(uint64_t))
+			{
+				counters->value[i] = 0;
+			}
+		}
+	}
+}
+
+/*
+ * Workloads
+ *
+ * setup is not measured, run returns the number of elements processed so
+ * that totals can be normalized per element.
+ */
+
+typedef struct {
+	size_t n;
+	SLIST_NODE(uint32_t)* nodes;
+	size_t* order;
+	SLIST_NODE(uint32_t)* list;
+} sBench;
+
+typedef struct {
+	const char* name;
+	void (*setup)(sBench* bench);
+	size_t (*run)(sBench* bench);
+} sWorkload;
+
+static volatile uint64_t sink;
+
+static void link_in_order(sBench* bench)
+{
+	// Linked by hand: building through SLIST_ADD_NODE is what "add" measures
+	bench->list = NULL;
+	SLIST_NODE(uint32_t)** tail = &bench->list;
+	for (size_t i = 0; i < bench->n; i++)
+	{
+		SLIST_NODE(uint32_t)* node = &bench->nodes[bench->order[i]];
+		*tail = node;
+		tail = &node->next;
+	}
+	*tail = NULL;
+}
+
+static void setup_add(sBench* bench)
+{
+	bench->list = NULL;
+}
+
+static size_t run_add(sBench* bench)
+{
+	for (size_t i = 0; i < bench->n; i++)
+	{
+		SLIST_ADD_NODE_PTR(uint32_t, bench->list, &bench->nodes[bench->order[i]]);
+	}
+	return bench->n;
+}
+
+#define ITERATE_MIN_ELEMENTS (1u << 22)
+
+static size_t run_iterate(sBench* bench)
+{
+	size_t passes = 1 + ITERATE_MIN_ELEMENTS / bench->n;
+	uint64_t sum = 0;
+	for (size_t pass = 0; pass < passes; pass++)
+	{
+		SLIST_FOR_EACH_NODE_PTR(uint32_t, bench->list, node)
+		{
+			sum += node->data;
+		}
+	}
+	sink = sum;
+	return passes * bench->n;
+}
+
+static size_t run_pop(sBench* bench)
+{
+	uint64_t sum = 0;
+	SLIST_NODE(uint32_t)* node;
+	while ((node = SLIST_POP_NODE(uint32_t, bench->list)) != NULL)
+	{
+		sum += node->data;
+	}
+	sink = sum;
+	return bench->n;
+}
+
+static const sWorkload workloads[] = {
+	{ "add", setup_add, run_add },
+	{ "iterate", link_in_order, run_iterate },
+	{ "pop", link_in_order, run_pop },
+};
+
+#define WORKLOADS (sizeof(workloads) / sizeof(workloads[0]))
+
+/*
+ * Harness
+ */
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void make_order(sBench* bench, int scattered)
+{
+	for (size_t i = 0; i < bench->n; i++)
+	{
+		bench->order[i] = i;
+	}
+	if (scattered)
+	{
+		srand(1);
+		for (size_t i = bench->n - 1; i > 0; i--)
+		{
+			size_t j = (size_t)rand() % (i + 1);
+			size_t tmp = bench->order[i];
+			bench->order[i] = bench->order[j];
+			bench->order[j] = tmp;
+		}
+	}
+}
+
+static void print_result(const char* workload, const char* layout, size_t n,
+	size_t elements, uint64_t ns, const sCounters* counters, int first)
+{
+	printf("%s\n    {\"workload\": \"%s\", \"layout\": \"%s\", \"n\": %lu, "
+		"\"elements\": %lu, \"ns\": %llu, \"ns_per_element\": %.3f",
+		first ? "" : ",", workload, layout, (unsigned long)n,
+		(unsigned long)elements, (unsigned long long)ns, (double)ns / (double)elements);
+	if (counters != NULL)
+	{
+		printf(", \"counters\": {");
+		for (size_t i = 0; i < COUNTERS; i++)
+		{
+			const char* sep = i == 0 ? "" : ", ";
+			if (counters->fd[i] < 0)
+			{
+				printf("%s\"%s\": null, \"%s_per_element\": null", sep,
+					counterSpecs[i].name, counterSpecs[i].name);
+			}
+			else
+			{
+				printf("%s\"%s\": %llu, \"%s_per_element\": %.4f", sep,
+					counterSpecs[i].name, (unsigned long long)counters->value[i],
+					counterSpecs[i].name, (double)counters->value[i] / (double)elements);
+			}
+		}
+		printf("}");
+	}
+	printf("}");
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [-n elements] [--perf]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = 4096;
+	int perf = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			n = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--perf") == 0)
+		{
+			perf = 1;
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (n == 0)
+	{
+		usage(argv[0]);
+	}
+
+	sBench bench;
+	bench.n = n;
+	bench.nodes = calloc(n, sizeof(*bench.nodes));
+	bench.order = calloc(n, sizeof(*bench.order));
+	if (bench.nodes == NULL || bench.order == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	for (size_t i = 0; i < n; i++)
+	{
+		bench.nodes[i].data = (uint32_t)i;
+	}
+
+	sCounters counters;
+	if (perf)
+	{
+		counters_open(&counters);
+	}
+
+	static const char* const layouts[] = { "sequential", "scattered" };
+	int first = 1;
+	printf("{\"benchmark\": \"slist\", \"perf\": %s, \"results\": [", perf ? "true" : "false");
+	for (size_t layout = 0; layout < 2; layout++)
+	{
+		make_order(&bench, (int)layout);
+		for (size_t w = 0; w < WORKLOADS; w++)
+		{
+			workloads[w].setup(&bench);
+			if (perf)
+			{
+				counters_start(&counters);
+			}
+			uint64_t start = now_ns();
+			size_t elements = workloads[w].run(&bench);
+			uint64_t ns = now_ns() - start;
+			if (perf)
+			{
+				counters_stop(&counters);
+			}
+			print_result(workloads[w].name, layouts[layout], n, elements, ns,
+				perf ? &counters : NULL, first);
+			first = 0;
+		}
+	}
+	printf("\n]}\n");
+
+	if (perf)
+	{
+		counters_close(&counters);
+	}
+	free(bench.nodes);
+	free(bench.order);
+	return 0;
+}
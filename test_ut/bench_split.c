@@ -0,0 +1,183 @@
+/**
+ * Hot/cold split benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -I.. -o bench_split bench_split.c
+ *	./bench_split [-n nodes] [--searches count]
+ *
+ * For records of 64 B to 1 KB, n nodes are linked in a random permutation and
+ * searched for keys that are not present, so every search walks the whole
+ * list. The same records are walked stored inline in the nodes (inline) and
+ * split into a hot node plus a cold part in a parallel array (split). The ns
+ * per node visited are printed as JSON.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_split_template.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t random_state = 88172645463325252ull;
+
+static uint64_t random_next(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return random_state;
+}
+
+static void shuffle(size_t* order, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		order[i] = i;
+	}
+	for (size_t i = n - 1; i > 0; i--)
+	{
+		size_t j = random_next() % (i + 1);
+		size_t tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+#define KEY_EQ(a, b) (*(a) == *(b))
+
+/*
+ * One record type, inline list and split list per payload size
+ */
+
+#define BENCH_PAYLOAD(P) \
+typedef struct { \
+	uint32_t key; \
+	uint8_t payload[(P) - sizeof(uint32_t)]; \
+} sRecord##P; \
+SLIST_DECLARE_STATIC(sRecord##P); \
+SLIST_DEFINE_STATIC(sRecord##P); \
+SLIST_SPLIT_DECLARE_STATIC(sHot##P, uint32_t, sRecord##P); \
+SLIST_SPLIT_DEFINE_STATIC(sHot##P, KEY_EQ); \
+\
+static void bench_##P(size_t n, size_t searches, const size_t* order, int first) \
+{ \
+	SLIST_NODE(sRecord##P)* inlineNodes = calloc(n, sizeof(*inlineNodes)); \
+	SLIST_NODE(sHot##P)* hotNodes = calloc(n, sizeof(*hotNodes)); \
+	sRecord##P* coldRecords = calloc(n, sizeof(*coldRecords)); \
+	if (inlineNodes == NULL || hotNodes == NULL || coldRecords == NULL) \
+	{ \
+		fprintf(stderr, "out of memory\n"); \
+		exit(1); \
+	} \
+	SLIST_NODE(sRecord##P)* inlineList = NULL; \
+	SLIST_NODE(sHot##P)* splitList = NULL; \
+	for (size_t i = n; i-- > 0;) \
+	{ \
+		size_t at = order[i]; \
+		inlineNodes[at].data.key = (uint32_t)at; \
+		inlineNodes[at].next = inlineList; \
+		inlineList = &inlineNodes[at]; \
+		coldRecords[at].key = (uint32_t)at; \
+		SLIST_SPLIT_BIND(hotNodes[at], (uint32_t)at, &coldRecords[at]); \
+		hotNodes[at].next = splitList; \
+		splitList = &hotNodes[at]; \
+	} \
+	\
+	uint64_t start = now_ns(); \
+	size_t hits = 0; \
+	for (size_t s = 0; s < searches; s++) \
+	{ \
+		uint32_t key = (uint32_t)(n + s); \
+		SLIST_FOR_EACH_NODE_PTR(sRecord##P, inlineList, node) \
+		{ \
+			if (node->data.key == key) \
+			{ \
+				hits++; \
+			} \
+		} \
+	} \
+	uint64_t inlineNs = now_ns() - start; \
+	\
+	start = now_ns(); \
+	for (size_t s = 0; s < searches; s++) \
+	{ \
+		hits += (SLIST_SPLIT_FIND(sHot##P, splitList, (uint32_t)(n + s)) != NULL); \
+	} \
+	uint64_t splitNs = now_ns() - start; \
+	\
+	double visited = (double)n * (double)searches; \
+	printf("%s\n    {\"payload\": %d, \"inline_node\": %lu, \"split_node\": %lu, " \
+		"\"inline_ns_per_node\": %.3f, \"split_ns_per_node\": %.3f, \"hits\": %lu}", \
+		first ? "" : ",", (P), (unsigned long)sizeof(SLIST_NODE(sRecord##P)), \
+		(unsigned long)sizeof(SLIST_NODE(sHot##P)), \
+		(double)inlineNs / visited, (double)splitNs / visited, (unsigned long)hits); \
+	free(inlineNodes); \
+	free(hotNodes); \
+	free(coldRecords); \
+}
+
+BENCH_PAYLOAD(64)
+BENCH_PAYLOAD(128)
+BENCH_PAYLOAD(256)
+BENCH_PAYLOAD(512)
+BENCH_PAYLOAD(1024)
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [-n nodes] [--searches count]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = 100000;
+	size_t searches = 20;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			n = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--searches") == 0 && i + 1 < argc)
+		{
+			searches = strtoul(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (n == 0 || searches == 0)
+	{
+		usage(argv[0]);
+	}
+
+	size_t* order = malloc(n * sizeof(size_t));
+	if (order == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	shuffle(order, n);
+
+	printf("{\"benchmark\": \"split\", \"n\": %lu, \"searches\": %lu, \"results\": [",
+		(unsigned long)n, (unsigned long)searches);
+	bench_64(n, searches, order, 1);
+	bench_128(n, searches, order, 0);
+	bench_256(n, searches, order, 0);
+	bench_512(n, searches, order, 0);
+	bench_1024(n, searches, order, 0);
+	printf("\n]}\n");
+
+	free(order);
+	return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * SPSC queue benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -pthread -I.. -o bench_spsc bench_spsc.c
+ *	./bench_spsc [--ops operations] [--window nodes]
+ *
+ * A producer thread hands nodes over to a consumer thread, through the wait-free
+ * SPSC queue (spsc) and through a list guarded by a mutex, adding with
+ * SLIST_ADD_NODE and popping with SLIST_POP_NODE (mutex). The producer stamps
+ * every node and the consumer measures its latency, the producer never being
+ * more than window nodes ahead so that the mutex list stays short. Throughput
+ * (ops/s) and latency percentiles (ns) are printed as JSON. Threads are pinned
+ * to different CPUs when there are enough of them.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_spsc_template.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+SLIST_DECLARE_STATIC(uint64_t);
+SLIST_DEFINE_STATIC(uint64_t);
+SLIST_SPSC_DECLARE_STATIC(uint64_t);
+SLIST_SPSC_DEFINE_STATIC(uint64_t)
+
+static SLIST_SPSC(uint64_t) queue;
+static SLIST_NODE(uint64_t)* list;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+static SLIST_NODE(uint64_t)* nodes;
+static uint64_t* latencies;
+static size_t ops;
+static size_t window;
+static SLIST_CACHE_ALIGNED size_t consumed;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void pin(int cpu)
+{
+	if (cpu < sysconf(_SC_NPROCESSORS_ONLN))
+	{
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(cpu, &cpus);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+	}
+}
+
+static void wait_window(size_t produced)
+{
+	while (produced - __atomic_load_n(&consumed, __ATOMIC_ACQUIRE) >= window)
+	{
+		sched_yield();
+	}
+}
+
+static void* produce_spsc(void* argument)
+{
+	(void)argument;
+	pin(0);
+	for (size_t i = 0; i < ops; i++)
+	{
+		wait_window(i);
+		nodes[i].data = now_ns();
+		SLIST_SPSC_PUSH(uint64_t, queue, nodes[i]);
+	}
+	return NULL;
+}
+
+static void* consume_spsc(void* argument)
+{
+	(void)argument;
+	pin(1);
+	for (size_t i = 0; i < ops;)
+	{
+		SLIST_NODE(uint64_t)* node = SLIST_SPSC_POP(uint64_t, queue);
+		if (node == NULL)
+		{
+			sched_yield();
+			continue;
+		}
+		latencies[i++] = now_ns() - node->data;
+		__atomic_store_n(&consumed, i, __ATOMIC_RELEASE);
+	}
+	return NULL;
+}
+
+static void* produce_mutex(void* argument)
+{
+	(void)argument;
+	pin(0);
+	for (size_t i = 0; i < ops; i++)
+	{
+		wait_window(i);
+		nodes[i].data = now_ns();
+		pthread_mutex_lock(&lock);
+		SLIST_ADD_NODE(uint64_t, list, nodes[i]);
+		pthread_mutex_unlock(&lock);
+	}
+	return NULL;
+}
+
+static void* consume_mutex(void* argument)
+{
+	(void)argument;
+	pin(1);
+	for (size_t i = 0; i < ops;)
+	{
+		pthread_mutex_lock(&lock);
+		SLIST_NODE(uint64_t)* node = SLIST_POP_NODE(uint64_t, list);
+		pthread_mutex_unlock(&lock);
+		if (node == NULL)
+		{
+			sched_yield();
+			continue;
+		}
+		latencies[i++] = now_ns() - node->data;
+		__atomic_store_n(&consumed, i, __ATOMIC_RELEASE);
+	}
+	return NULL;
+}
+
+static int compare_u64(const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static void run(const char* name, void* (*produce)(void*), void* (*consume)(void*), int first)
+{
+	pthread_t producer;
+	pthread_t consumer;
+	for (size_t i = 0; i < ops; i++)
+	{
+		nodes[i].next = NULL;
+	}
+	consumed = 0;
+	uint64_t begin = now_ns();
+	pthread_create(&consumer, NULL, consume, NULL);
+	pthread_create(&producer, NULL, produce, NULL);
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+	uint64_t elapsed = now_ns() - begin;
+	qsort(latencies, ops, sizeof(uint64_t), compare_u64);
+	printf("%s\n    {\"queue\": \"%s\", \"ops_per_s\": %.0f, \"p50_ns\": %lu, \"p99_ns\": %lu, \"max_ns\": %lu}",
+		first ? "" : ",", name, (double)ops * 1e9 / (double)elapsed,
+		(unsigned long)latencies[ops / 2], (unsigned long)latencies[ops - 1 - ops / 100],
+		(unsigned long)latencies[ops - 1]);
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [--ops operations] [--window nodes]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	ops = 1000000;
+	window = 64;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+		{
+			ops = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc)
+		{
+			window = strtoul(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (ops == 0 || window == 0)
+	{
+		usage(argv[0]);
+	}
+
+	nodes = calloc(ops, sizeof(*nodes));
+	latencies = malloc(ops * sizeof(uint64_t));
+	if (nodes == NULL || latencies == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	SLIST_SPSC_INIT(uint64_t, queue);
+
+	printf("{\"benchmark\": \"spsc\", \"ops\": %lu, \"window\": %lu, \"cpus\": %ld, \"results\": [",
+		(unsigned long)ops, (unsigned long)window, sysconf(_SC_NPROCESSORS_ONLN));
+	run("spsc", produce_spsc, consume_spsc, 1);
+	run("mutex", produce_mutex, consume_mutex, 0);
+	printf("\n]}\n");
+
+	free(nodes);
+	free(latencies);
+	return 0;
+}
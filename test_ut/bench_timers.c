@@ -0,0 +1,212 @@
+/**
+ * Timer queue benchmark to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O2 -std=c99 -I.. -o bench_timers bench_timers.c
+ *	./bench_timers [-n timers] [--ops operations] [--horizon ticks]
+ *
+ * Classic hold model: n timers are armed with random deadlines, then every
+ * operation expires the earliest timer and re-arms it at a random time up to
+ * horizon ticks later. Compared implementations, all over the same nodes:
+ *
+ * - heap: the intrusive pairing heap (slist_heap_template.h)
+ * - sorted: a list kept sorted by insertion through a cursor, O(N) inserts
+ * - wheel: a hashed timing wheel of lists with one slot per tick
+ *
+ * Results are printed as JSON with the ns per hold operation.
+ */
+
+#define _GNU_SOURCE
+
+#include "../slist_heap_template.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+	uint64_t deadline;
+} sTimer;
+
+#define TIMER_LESS(a, b) ((a)->deadline < (b)->deadline)
+
+SLIST_DECLARE_STATIC(sTimer);
+SLIST_DEFINE_STATIC(sTimer);
+SLIST_DECLARE_CURSOR_STATIC(sTimer);
+SLIST_DEFINE_CURSOR_STATIC(sTimer);
+SLIST_HEAP_DECLARE_STATIC(sTimer);
+SLIST_HEAP_DEFINE_STATIC(sTimer, TIMER_LESS);
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t random_state = 88172645463325252ull;
+
+static uint64_t random_delay(uint64_t horizon)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return 1 + random_state % horizon;
+}
+
+/*
+ * Implementations: arm a timer, expire the earliest
+ */
+
+typedef struct {
+	SLIST_HEAP(sTimer) heap;
+	SLIST_NODE(sTimer)* sorted;
+	SLIST_NODE(sTimer)** wheel;
+	uint64_t wheelSize;
+	uint64_t tick;
+} sQueues;
+
+static void heap_arm(sQueues* queues, SLIST_HEAP_NODE(sTimer)* timer)
+{
+	SLIST_HEAP_INSERT_PTR(sTimer, queues->heap, timer);
+}
+
+static SLIST_HEAP_NODE(sTimer)* heap_expire(sQueues* queues)
+{
+	return SLIST_HEAP_POP_MIN(sTimer, queues->heap);
+}
+
+static void sorted_arm(sQueues* queues, SLIST_HEAP_NODE(sTimer)* timer)
+{
+	SLIST_CREATE_CURSOR(sTimer, cursor, queues->sorted);
+	SLIST_NODE(sTimer)* next = queues->sorted;
+	while (next != NULL && next->data.deadline <= timer->link.data.deadline)
+	{
+		next = SLIST_CURSOR_NEXT(sTimer, cursor)->next;
+	}
+	SLIST_CURSOR_INSERT_AFTER_PTR(sTimer, cursor, &timer->link);
+}
+
+static SLIST_HEAP_NODE(sTimer)* sorted_expire(sQueues* queues)
+{
+	return (SLIST_HEAP_NODE(sTimer)*)SLIST_POP_NODE(sTimer, queues->sorted);
+}
+
+static void wheel_arm(sQueues* queues, SLIST_HEAP_NODE(sTimer)* timer)
+{
+	// Order inside a slot does not matter, every node there expires at once
+	SLIST_NODE(sTimer)** slot = &queues->wheel[timer->link.data.deadline % queues->wheelSize];
+	timer->link.next = *slot;
+	*slot = &timer->link;
+}
+
+static SLIST_HEAP_NODE(sTimer)* wheel_expire(sQueues* queues)
+{
+	for (;;)
+	{
+		SLIST_NODE(sTimer)** slot = &queues->wheel[queues->tick % queues->wheelSize];
+		if (*slot != NULL)
+		{
+			return (SLIST_HEAP_NODE(sTimer)*)SLIST_POP_NODE(sTimer, *slot);
+		}
+		queues->tick++;
+	}
+}
+
+typedef struct {
+	const char* name;
+	void (*arm)(sQueues* queues, SLIST_HEAP_NODE(sTimer)* timer);
+	SLIST_HEAP_NODE(sTimer)* (*expire)(sQueues* queues);
+} sImplementation;
+
+static const sImplementation implementations[] = {
+	{ "heap", heap_arm, heap_expire },
+	{ "sorted", sorted_arm, sorted_expire },
+	{ "wheel", wheel_arm, wheel_expire },
+};
+
+#define IMPLEMENTATIONS (sizeof(implementations) / sizeof(implementations[0]))
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [-n timers] [--ops operations] [--horizon ticks]\n", program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t n = 1024;
+	size_t ops = 1000000;
+	uint64_t horizon = 4096;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			n = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+		{
+			ops = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc)
+		{
+			horizon = strtoull(argv[++i], NULL, 0);
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (n == 0 || horizon == 0)
+	{
+		usage(argv[0]);
+	}
+
+	SLIST_HEAP_NODE(sTimer)* timers = calloc(n, sizeof(*timers));
+	sQueues queues;
+	queues.wheelSize = horizon + 1;
+	queues.wheel = calloc(queues.wheelSize, sizeof(*queues.wheel));
+	if (timers == NULL || queues.wheel == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+
+	printf("{\"benchmark\": \"timers\", \"n\": %lu, \"horizon\": %llu, \"results\": [",
+		(unsigned long)n, (unsigned long long)horizon);
+	for (size_t impl = 0; impl < IMPLEMENTATIONS; impl++)
+	{
+		const sImplementation* queue = &implementations[impl];
+		SLIST_CREATE_HEAP(sTimer, heap);
+		queues.heap = heap;
+		queues.sorted = NULL;
+		queues.tick = 0;
+		memset(queues.wheel, 0, queues.wheelSize * sizeof(*queues.wheel));
+		random_state = 88172645463325252ull;
+		for (size_t i = 0; i < n; i++)
+		{
+			timers[i].link.data.deadline = random_delay(horizon);
+			queue->arm(&queues, &timers[i]);
+		}
+
+		uint64_t check = 0;
+		uint64_t start = now_ns();
+		for (size_t i = 0; i < ops; i++)
+		{
+			SLIST_HEAP_NODE(sTimer)* timer = queue->expire(&queues);
+			check += timer->link.data.deadline;
+			timer->link.data.deadline += random_delay(horizon);
+			queue->arm(&queues, timer);
+		}
+		uint64_t elapsed = now_ns() - start;
+
+		printf("%s\n    {\"queue\": \"%s\", \"ops\": %lu, \"ns_per_op\": %.3f, \"check\": %llu}",
+			impl == 0 ? "" : ",", queue->name, (unsigned long)ops,
+			(double)elapsed / (double)ops, (unsigned long long)check);
+	}
+	printf("\n]}\n");
+
+	free(timers);
+	free(queues.wheel);
+	return 0;
+}
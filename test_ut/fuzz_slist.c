@@ -0,0 +1,71 @@
+/**
+ * Fuzz harness for the list operations, checked against the reference model
+ * of slist_model.h (any input is a valid sequence of operations).
+ *
+ * libFuzzer:
+ *
+ *	clang -g -O1 -fsanitize=fuzzer,address,undefined -I.. -o fuzz_slist fuzz_slist.c
+ *	./fuzz_slist -max_len=4096 corpus/
+ *
+ * AFL, or any compiler to replay inputs (files given, or stdin):
+ *
+ *	afl-clang-fast -g -O1 -fsanitize=address,undefined -DSLIST_FUZZ_MAIN -I.. -o fuzz_slist fuzz_slist.c
+ *	afl-fuzz -i seeds -o findings -- ./fuzz_slist
+ *
+ *	gcc -g -O1 -std=c99 -fsanitize=address,undefined -DSLIST_FUZZ_MAIN -I.. -o fuzz_slist fuzz_slist.c
+ *	./fuzz_slist findings/default/crashes/id:000000*
+ *
+ * A mismatch with the model aborts, printing the failing step. Adding
+ * -DSLIST_ENABLE_VALIDATION also checks every list for cycles.
+ */
+
+#include "slist_model.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+	model_run(data, size);
+	return 0;
+}
+
+#ifdef SLIST_FUZZ_MAIN
+
+#define INPUT_MAX (1u << 20)
+
+static int replay(FILE* file)
+{
+	static uint8_t input[INPUT_MAX];
+	size_t size = fread(input, 1, sizeof(input), file);
+	if (ferror(file))
+	{
+		return 1;
+	}
+	LLVMFuzzerTestOneInput(input, size);
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		return replay(stdin);
+	}
+	for (int i = 1; i < argc; i++)
+	{
+		FILE* file = fopen(argv[i], "rb");
+		if (file == NULL || replay(file) != 0)
+		{
+			perror(argv[i]);
+			return 1;
+		}
+		fclose(file);
+	}
+	return 0;
+}
+
+#endif /* SLIST_FUZZ_MAIN */
@@ -0,0 +1,634 @@
+/*
+ * Reference model shared by test_slist_property.c and fuzz_slist.c
+ *
+ * A byte string is decoded into a sequence of list operations, applied both
+ * to real lists over a small node pool and to a model where every list is an
+ * array of node indices. After each operation every list is walked and
+ * compared with its model, as are the values returned by the operation.
+ *
+ *	- plain lists 0..2: add, pop, cursor insert/remove, partition, dedup,
+ *	  merge, merge k, reverse, rotate, split at
+ *	- bounded list 3 (MODEL_BOUNDED_MAX): add under both policies, pop,
+ *	  reverse, rotate, split at
+ *	- counted lists 4 and 5: add, pop, remove, splice
+ *
+ * Operations whose preconditions do not hold (a node on another list, merging
+ * unsorted lists...) are skipped, so any input is valid. A mismatch calls
+ * MODEL_CHECK, which the includer may define before including this file
+ * (abort by default). Instantiates the uint32_t lists, which the includer
+ * must not instantiate again.
+ */
+
+#ifndef SLIST_MODEL_H_
+#define SLIST_MODEL_H_
+
+#include "slist_template.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef MODEL_CHECK
+#define MODEL_CHECK(cond_) \
+do { if (!(cond_)) { fprintf(stderr, "step %lu: %s\n", (unsigned long)modelStep, #cond_); abort(); } } while (0)
+#endif
+
+#define MODEL_NODES 16u
+#define MODEL_PLAIN 3u
+#define MODEL_BOUNDED 3u
+#define MODEL_COUNTED 4u
+#define MODEL_SEQUENCES 6u
+#define MODEL_BOUNDED_MAX 5
+#define MODEL_VALUES 8u
+#define MODEL_FREE 0xffu
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_CURSOR_STATIC(uint32_t);
+SLIST_DEFINE_CURSOR_STATIC(uint32_t);
+SLIST_DECLARE_PARTITION_STATIC(uint32_t);
+SLIST_DEFINE_PARTITION_STATIC(uint32_t);
+SLIST_DECLARE_DEDUP_STATIC(uint32_t);
+SLIST_DEFINE_DEDUP_STATIC(uint32_t);
+SLIST_DECLARE_MERGE_STATIC(uint32_t);
+SLIST_DEFINE_MERGE_STATIC(uint32_t);
+SLIST_DECLARE_REORDER_STATIC(uint32_t);
+SLIST_DEFINE_REORDER_STATIC(uint32_t);
+SLIST_DECLARE_BOUNDED_STATIC(uint32_t, MODEL_BOUNDED_MAX);
+SLIST_DEFINE_BOUNDED_STATIC(uint32_t, MODEL_BOUNDED_MAX);
+SLIST_DECLARE_BOUNDED_REORDER_STATIC(uint32_t, MODEL_BOUNDED_MAX);
+SLIST_DEFINE_BOUNDED_REORDER_STATIC(uint32_t, MODEL_BOUNDED_MAX);
+SLIST_DECLARE_COUNTED_STATIC(uint32_t);
+SLIST_DEFINE_COUNTED_STATIC(uint32_t);
+
+typedef enum {
+	MODEL_ADD,
+	MODEL_POP,
+	MODEL_CURSOR_INSERT,
+	MODEL_CURSOR_REMOVE,
+	MODEL_PARTITION,
+	MODEL_DEDUP,
+	MODEL_MERGE,
+	MODEL_MERGE_K,
+	MODEL_REVERSE,
+	MODEL_ROTATE,
+	MODEL_SPLIT_AT,
+	MODEL_BOUNDED_ADD,
+	MODEL_BOUNDED_POP,
+	MODEL_BOUNDED_REVERSE,
+	MODEL_BOUNDED_ROTATE,
+	MODEL_BOUNDED_SPLIT_AT,
+	MODEL_COUNTED_ADD,
+	MODEL_COUNTED_POP,
+	MODEL_COUNTED_REMOVE,
+	MODEL_COUNTED_SPLICE,
+	MODEL_SET_VALUE,
+	MODEL_OPERATIONS
+} eModelOperation;
+
+static SLIST_NODE(uint32_t) modelNodes[MODEL_NODES];
+static SLIST_NODE(uint32_t)* modelLists[MODEL_PLAIN];
+static SLIST_BOUNDED(uint32_t, MODEL_BOUNDED_MAX) modelBounded;
+static SLIST_COUNTED(uint32_t) modelCounted[2];
+
+static uint8_t modelSequence[MODEL_SEQUENCES][MODEL_NODES];
+static size_t modelLength[MODEL_SEQUENCES];
+static uint8_t modelOwner[MODEL_NODES];
+static size_t modelStep;
+
+static const uint8_t* modelInput;
+static size_t modelInputSize;
+static size_t modelInputAt;
+
+static uint8_t model_byte(void)
+{
+	return (modelInputAt < modelInputSize) ? modelInput[modelInputAt++] : 0;
+}
+
+#define MODEL_NODE(s_, i_) \
+(&modelNodes[modelSequence[s_][i_]])
+
+static void model_insert(size_t s, size_t at, uint8_t node)
+{
+	for (size_t i = modelLength[s]; i > at; i--)
+	{
+		modelSequence[s][i] = modelSequence[s][i - 1];
+	}
+	modelSequence[s][at] = node;
+	modelLength[s]++;
+	modelOwner[node] = (uint8_t)s;
+}
+
+static uint8_t model_remove(size_t s, size_t at)
+{
+	uint8_t node = modelSequence[s][at];
+	for (size_t i = at; i + 1 < modelLength[s]; i++)
+	{
+		modelSequence[s][i] = modelSequence[s][i + 1];
+	}
+	modelLength[s]--;
+	modelOwner[node] = MODEL_FREE;
+	return node;
+}
+
+/* Moves the nodes of sequence from, starting at index at, to the end of to */
+static void model_move_tail(size_t from, size_t at, size_t to)
+{
+	while (modelLength[from] > at)
+	{
+		uint8_t node = model_remove(from, at);
+		if (to != MODEL_FREE)
+		{
+			model_insert(to, modelLength[to], node);
+		}
+	}
+}
+
+static int model_is_sorted(size_t s)
+{
+	for (size_t i = 1; i < modelLength[s]; i++)
+	{
+		if (MODEL_NODE(s, i)->data < MODEL_NODE(s, i - 1)->data)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Checks that a chain holds exactly the nodes of sequence s from index at */
+static void model_check_chain(SLIST_NODE(uint32_t)* head, size_t s, size_t at)
+{
+	size_t i = at;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, head, node)
+	{
+		MODEL_CHECK(i < modelLength[s]);
+		MODEL_CHECK(node == MODEL_NODE(s, i));
+		i++;
+	}
+	MODEL_CHECK(i == modelLength[s]);
+}
+
+static void model_check(void)
+{
+	for (size_t s = 0; s < MODEL_PLAIN; s++)
+	{
+		model_check_chain(modelLists[s], s, 0);
+	}
+	model_check_chain(SLIST_BOUNDED_HEAD(modelBounded), MODEL_BOUNDED, 0);
+	MODEL_CHECK(SLIST_BOUNDED_COUNT(modelBounded) == modelLength[MODEL_BOUNDED]);
+	MODEL_CHECK(modelBounded.tail == ((modelLength[MODEL_BOUNDED] == 0) ? NULL :
+		MODEL_NODE(MODEL_BOUNDED, modelLength[MODEL_BOUNDED] - 1)));
+	for (size_t c = 0; c < 2; c++)
+	{
+		model_check_chain(SLIST_COUNTED_HEAD(modelCounted[c]), MODEL_COUNTED + c, 0);
+		MODEL_CHECK(SLIST_COUNTED_SIZE(modelCounted[c]) == modelLength[MODEL_COUNTED + c]);
+	}
+}
+
+static size_t model_classify(const uint32_t* data, void* context)
+{
+	(void)context;
+	return *data % 3u;
+}
+
+static size_t model_hash(const uint32_t* data)
+{
+	return *data * 2654435761u;
+}
+
+static int model_eq(const uint32_t* a, const uint32_t* b)
+{
+	return *a == *b;
+}
+
+static int model_less(const uint32_t* a, const uint32_t* b)
+{
+	return *a < *b;
+}
+
+/*
+ * Operations over the plain lists
+ */
+
+static void model_add(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	uint8_t node = model_byte() % MODEL_NODES;
+	if (modelOwner[node] == MODEL_FREE)
+	{
+		MODEL_CHECK(SLIST_ADD_NODE_PTR(uint32_t, modelLists[s], &modelNodes[node]) == 1);
+		model_insert(s, modelLength[s], node);
+	}
+	else if (modelOwner[node] == s)
+	{
+		MODEL_CHECK(SLIST_ADD_NODE_PTR(uint32_t, modelLists[s], &modelNodes[node]) == 0);
+	}
+}
+
+static void model_pop(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	SLIST_NODE(uint32_t)* popped = SLIST_POP_NODE(uint32_t, modelLists[s]);
+	if (modelLength[s] == 0)
+	{
+		MODEL_CHECK(popped == NULL);
+		return;
+	}
+	MODEL_CHECK(popped == MODEL_NODE(s, 0));
+	MODEL_CHECK(popped->next == NULL);
+	model_remove(s, 0);
+}
+
+static void model_cursor(int insert)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	size_t at = model_byte() % (modelLength[s] + 1);
+	uint8_t node = model_byte() % MODEL_NODES;
+	SLIST_CREATE_CURSOR(uint32_t, cursor, modelLists[s]);
+	if (insert && modelOwner[node] != MODEL_FREE)
+	{
+		return;
+	}
+	for (size_t i = 0; i < at; i++)
+	{
+		MODEL_CHECK(SLIST_CURSOR_NEXT(uint32_t, cursor) == MODEL_NODE(s, i));
+	}
+	if (insert)
+	{
+		SLIST_CURSOR_INSERT_AFTER_PTR(uint32_t, cursor, &modelNodes[node]);
+		model_insert(s, at, node);
+	}
+	else
+	{
+		SLIST_NODE(uint32_t)* removed = SLIST_CURSOR_REMOVE_AFTER(uint32_t, cursor);
+		MODEL_CHECK(removed == ((at < modelLength[s]) ? MODEL_NODE(s, at) : NULL));
+		if (removed != NULL)
+		{
+			model_remove(s, at);
+		}
+	}
+}
+
+static void model_partition(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	size_t destinations[2] = { (s + 1) % MODEL_PLAIN, (s + 2) % MODEL_PLAIN };
+	SLIST_NODE(uint32_t)* lists[2] = { modelLists[destinations[0]], modelLists[destinations[1]] };
+	size_t expected = 0;
+	size_t moved = SLIST_PARTITION(uint32_t, modelLists[s], lists, 2, model_classify, NULL);
+	modelLists[destinations[0]] = lists[0];
+	modelLists[destinations[1]] = lists[1];
+	for (size_t i = 0; i < modelLength[s];)
+	{
+		size_t index = model_classify(&MODEL_NODE(s, i)->data, NULL);
+		if (index < 2)
+		{
+			uint8_t node = model_remove(s, i);
+			model_insert(destinations[index], modelLength[destinations[index]], node);
+			expected++;
+		}
+		else
+		{
+			i++;
+		}
+	}
+	MODEL_CHECK(moved == expected);
+}
+
+static void model_dedup(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	size_t capacity = model_byte() % (2 * MODEL_NODES + 1);
+	SLIST_NODE(uint32_t)* slots[2 * MODEL_NODES];
+	uint8_t removedNodes[MODEL_NODES];
+	size_t removedCount = 0;
+	int recorded[MODEL_VALUES] = { 0 };
+	size_t used = 0;
+	SLIST_NODE(uint32_t)* removed = SLIST_DEDUP(uint32_t, modelLists[s], model_hash, model_eq, slots, capacity);
+	for (size_t i = 0; i < modelLength[s];)
+	{
+		uint32_t value = MODEL_NODE(s, i)->data;
+		if (recorded[value])
+		{
+			removedNodes[removedCount++] = model_remove(s, i);
+			continue;
+		}
+		if (used < capacity)
+		{
+			recorded[value] = 1;
+			used++;
+		}
+		i++;
+	}
+	for (size_t i = 0; i < removedCount; i++)
+	{
+		MODEL_CHECK(removed == &modelNodes[removedNodes[i]]);
+		removed = removed->next;
+	}
+	MODEL_CHECK(removed == NULL);
+}
+
+static void model_merge(void)
+{
+	size_t a = model_byte() % MODEL_PLAIN;
+	size_t b = model_byte() % MODEL_PLAIN;
+	if (a == b || !model_is_sorted(a) || !model_is_sorted(b))
+	{
+		return;
+	}
+	modelLists[a] = SLIST_MERGE(uint32_t, modelLists[a], modelLists[b], model_less);
+	modelLists[b] = NULL;
+	// Stable: of equal values those of a come first
+	for (size_t i = 0; modelLength[b] > 0;)
+	{
+		uint32_t value = MODEL_NODE(b, 0)->data;
+		while (i < modelLength[a] && MODEL_NODE(a, i)->data <= value)
+		{
+			i++;
+		}
+		model_insert(a, i++, model_remove(b, 0));
+	}
+}
+
+static void model_merge_k(void)
+{
+	size_t heap[MODEL_PLAIN];
+	for (size_t s = 0; s < MODEL_PLAIN; s++)
+	{
+		if (!model_is_sorted(s))
+		{
+			return;
+		}
+	}
+	SLIST_NODE(uint32_t)* merged = SLIST_MERGE_K(uint32_t, modelLists, MODEL_PLAIN, model_less, heap);
+	for (size_t s = 0; s < MODEL_PLAIN; s++)
+	{
+		MODEL_CHECK(modelLists[s] == NULL);
+	}
+	modelLists[0] = merged;
+	// Stable: of equal values those of a lower list come first
+	for (size_t s = 1; s < MODEL_PLAIN; s++)
+	{
+		for (size_t i = 0; modelLength[s] > 0;)
+		{
+			uint32_t value = MODEL_NODE(s, 0)->data;
+			while (i < modelLength[0] && MODEL_NODE(0, i)->data <= value)
+			{
+				i++;
+			}
+			model_insert(0, i++, model_remove(s, 0));
+		}
+	}
+}
+
+static void model_reverse_sequence(size_t s)
+{
+	for (size_t i = 0, j = modelLength[s]; i + 1 < j; i++, j--)
+	{
+		uint8_t node = modelSequence[s][i];
+		modelSequence[s][i] = modelSequence[s][j - 1];
+		modelSequence[s][j - 1] = node;
+	}
+}
+
+static void model_rotate_sequence(size_t s, size_t k)
+{
+	if (modelLength[s] == 0)
+	{
+		return;
+	}
+	for (k %= modelLength[s]; k > 0; k--)
+	{
+		model_insert(s, modelLength[s], model_remove(s, 0));
+	}
+}
+
+static void model_reverse(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	SLIST_NODE(uint32_t)* tail = SLIST_REVERSE(uint32_t, modelLists[s]);
+	MODEL_CHECK(tail == ((modelLength[s] == 0) ? NULL : MODEL_NODE(s, 0)));
+	model_reverse_sequence(s);
+}
+
+static void model_rotate(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	size_t k = model_byte();
+	SLIST_NODE(uint32_t)* tail = SLIST_ROTATE(uint32_t, modelLists[s], k);
+	model_rotate_sequence(s, k);
+	MODEL_CHECK(tail == ((modelLength[s] == 0) ? NULL : MODEL_NODE(s, modelLength[s] - 1)));
+}
+
+static void model_split_at(void)
+{
+	size_t s = model_byte() % MODEL_PLAIN;
+	size_t k = model_byte() % (MODEL_NODES + 1);
+	size_t d = model_byte() % MODEL_PLAIN;
+	if (d == s || modelLength[d] != 0)
+	{
+		return;
+	}
+	modelLists[d] = SLIST_SPLIT_AT(uint32_t, modelLists[s], k);
+	if (k < modelLength[s])
+	{
+		model_move_tail(s, k, d);
+	}
+}
+
+/*
+ * Operations over the bounded and counted lists
+ */
+
+static void model_bounded_add(void)
+{
+	uint8_t node = model_byte() % MODEL_NODES;
+	eSLIST_OverflowPolicy policy = (model_byte() & 1) ? SLIST_DROP_OLDEST : SLIST_DROP_NEW;
+	SLIST_NODE(uint32_t)* dropped;
+	if (modelOwner[node] != MODEL_FREE && modelOwner[node] != MODEL_BOUNDED)
+	{
+		return;
+	}
+	modelBounded.policy = policy;
+	dropped = SLIST_BOUNDED_ADD_PTR(uint32_t, MODEL_BOUNDED_MAX, modelBounded, &modelNodes[node]);
+	if (modelOwner[node] == MODEL_BOUNDED)
+	{
+		MODEL_CHECK(dropped == NULL);
+	}
+	else if (modelLength[MODEL_BOUNDED] < MODEL_BOUNDED_MAX)
+	{
+		MODEL_CHECK(dropped == NULL);
+		model_insert(MODEL_BOUNDED, modelLength[MODEL_BOUNDED], node);
+	}
+	else if (policy == SLIST_DROP_NEW)
+	{
+		MODEL_CHECK(dropped == &modelNodes[node]);
+	}
+	else
+	{
+		MODEL_CHECK(dropped == MODEL_NODE(MODEL_BOUNDED, 0));
+		model_remove(MODEL_BOUNDED, 0);
+		model_insert(MODEL_BOUNDED, modelLength[MODEL_BOUNDED], node);
+	}
+}
+
+static void model_bounded_pop(void)
+{
+	SLIST_NODE(uint32_t)* popped = SLIST_BOUNDED_POP(uint32_t, MODEL_BOUNDED_MAX, modelBounded);
+	if (modelLength[MODEL_BOUNDED] == 0)
+	{
+		MODEL_CHECK(popped == NULL);
+		return;
+	}
+	MODEL_CHECK(popped == MODEL_NODE(MODEL_BOUNDED, 0));
+	model_remove(MODEL_BOUNDED, 0);
+}
+
+static void model_bounded_split_at(void)
+{
+	size_t k = model_byte() % (MODEL_BOUNDED_MAX + 2);
+	SLIST_NODE(uint32_t)* rest = SLIST_BOUNDED_SPLIT_AT(uint32_t, MODEL_BOUNDED_MAX, modelBounded, k);
+	if (k < modelLength[MODEL_BOUNDED])
+	{
+		model_check_chain(rest, MODEL_BOUNDED, k);
+		model_move_tail(MODEL_BOUNDED, k, MODEL_FREE);
+	}
+	else
+	{
+		MODEL_CHECK(rest == NULL);
+	}
+}
+
+static void model_counted_add(void)
+{
+	size_t c = model_byte() % 2;
+	uint8_t node = model_byte() % MODEL_NODES;
+	if (modelOwner[node] == MODEL_FREE)
+	{
+		MODEL_CHECK(SLIST_COUNTED_ADD_PTR(uint32_t, modelCounted[c], &modelNodes[node]) == 1);
+		model_insert(MODEL_COUNTED + c, modelLength[MODEL_COUNTED + c], node);
+	}
+	else if (modelOwner[node] == MODEL_COUNTED + c)
+	{
+		MODEL_CHECK(SLIST_COUNTED_ADD_PTR(uint32_t, modelCounted[c], &modelNodes[node]) == 0);
+	}
+}
+
+static void model_counted_pop(void)
+{
+	size_t c = model_byte() % 2;
+	SLIST_NODE(uint32_t)* popped = SLIST_COUNTED_POP(uint32_t, modelCounted[c]);
+	if (modelLength[MODEL_COUNTED + c] == 0)
+	{
+		MODEL_CHECK(popped == NULL);
+		return;
+	}
+	MODEL_CHECK(popped == MODEL_NODE(MODEL_COUNTED + c, 0));
+	model_remove(MODEL_COUNTED + c, 0);
+}
+
+static void model_counted_remove(void)
+{
+	size_t c = model_byte() % 2;
+	uint8_t node = model_byte() % MODEL_NODES;
+	int removed = SLIST_COUNTED_REMOVE_PTR(uint32_t, modelCounted[c], &modelNodes[node]);
+	if (modelOwner[node] != MODEL_COUNTED + c)
+	{
+		MODEL_CHECK(removed == 0);
+		return;
+	}
+	MODEL_CHECK(removed == 1);
+	for (size_t i = 0; i < modelLength[MODEL_COUNTED + c]; i++)
+	{
+		if (modelSequence[MODEL_COUNTED + c][i] == node)
+		{
+			model_remove(MODEL_COUNTED + c, i);
+			break;
+		}
+	}
+}
+
+static void model_counted_splice(void)
+{
+	size_t c = model_byte() % 2;
+	SLIST_COUNTED_SPLICE(uint32_t, modelCounted[c], modelCounted[1 - c]);
+	model_move_tail(MODEL_COUNTED + 1 - c, 0, MODEL_COUNTED + c);
+}
+
+/*
+ * Runs the operations encoded in data from an empty state
+ */
+static void model_run(const uint8_t* data, size_t size)
+{
+	modelInput = data;
+	modelInputSize = size;
+	modelInputAt = 0;
+	for (size_t i = 0; i < MODEL_NODES; i++)
+	{
+		modelNodes[i].data = (uint32_t)(i % 5u);
+		modelNodes[i].next = NULL;
+		modelOwner[i] = MODEL_FREE;
+	}
+	for (size_t s = 0; s < MODEL_SEQUENCES; s++)
+	{
+		modelLength[s] = 0;
+	}
+	for (size_t s = 0; s < MODEL_PLAIN; s++)
+	{
+		modelLists[s] = NULL;
+	}
+	modelBounded.head = NULL;
+	modelBounded.tail = NULL;
+	modelBounded.count = 0;
+	modelBounded.policy = SLIST_DROP_NEW;
+	modelCounted[0].head = NULL;
+	modelCounted[0].count = 0;
+	modelCounted[1] = modelCounted[0];
+
+	for (modelStep = 0; modelInputAt < modelInputSize; modelStep++)
+	{
+		switch ((eModelOperation)(model_byte() % MODEL_OPERATIONS))
+		{
+			case MODEL_ADD: model_add(); break;
+			case MODEL_POP: model_pop(); break;
+			case MODEL_CURSOR_INSERT: model_cursor(1); break;
+			case MODEL_CURSOR_REMOVE: model_cursor(0); break;
+			case MODEL_PARTITION: model_partition(); break;
+			case MODEL_DEDUP: model_dedup(); break;
+			case MODEL_MERGE: model_merge(); break;
+			case MODEL_MERGE_K: model_merge_k(); break;
+			case MODEL_REVERSE: model_reverse(); break;
+			case MODEL_ROTATE: model_rotate(); break;
+			case MODEL_SPLIT_AT: model_split_at(); break;
+			case MODEL_BOUNDED_ADD: model_bounded_add(); break;
+			case MODEL_BOUNDED_POP: model_bounded_pop(); break;
+			case MODEL_BOUNDED_REVERSE:
+				SLIST_BOUNDED_REVERSE(uint32_t, MODEL_BOUNDED_MAX, modelBounded);
+				model_reverse_sequence(MODEL_BOUNDED);
+				break;
+			case MODEL_BOUNDED_ROTATE:
+			{
+				size_t k = model_byte();
+				SLIST_BOUNDED_ROTATE(uint32_t, MODEL_BOUNDED_MAX, modelBounded, k);
+				model_rotate_sequence(MODEL_BOUNDED, k);
+				break;
+			}
+			case MODEL_BOUNDED_SPLIT_AT: model_bounded_split_at(); break;
+			case MODEL_COUNTED_ADD: model_counted_add(); break;
+			case MODEL_COUNTED_POP: model_counted_pop(); break;
+			case MODEL_COUNTED_REMOVE: model_counted_remove(); break;
+			case MODEL_COUNTED_SPLICE: model_counted_splice(); break;
+			case MODEL_SET_VALUE:
+			{
+				uint8_t node = model_byte() % MODEL_NODES;
+				modelNodes[node].data = model_byte() % MODEL_VALUES;
+				break;
+			}
+			default: break;
+		}
+		model_check();
+	}
+}
+
+#endif /* SLIST_MODEL_H_ */
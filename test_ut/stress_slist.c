@@ -0,0 +1,536 @@
+/**
+ * Concurrency stress harness to be compiled and executed in a host PC (Linux)
+ *
+ *	gcc -O1 -g -std=c99 -pthread -fsanitize=thread -I.. -o stress_slist stress_slist.c
+ *	./stress_slist [--target spsc|locked|all] [--rounds n] [--ops n] [--threads n]
+ *		[--seed s] [--serial]
+ *
+ * Every round runs producers and consumers over a queue, records the history
+ * of operations (invocation and response on a global clock) and checks that
+ * it is linearizable with respect to a sequential FIFO queue of distinct
+ * values, looking for the patterns any violation must show: a value dequeued
+ * before being enqueued, twice or never, two values dequeued in the opposite
+ * order to their non overlapping enqueues, or an empty pop while a value was
+ * surely in the queue. Targets:
+ *
+ * - spsc: SLIST_SPSC_PUSH / SLIST_SPSC_POP, one producer and one consumer, with
+ *   yield points between the atomic steps (SLIST_SPSC_YIELD). As documented,
+ *   an empty pop overlapping a push is accepted.
+ * - locked: SLIST_ADD_NODE / SLIST_POP_NODE under a mutex, n producers and n
+ *   consumers, with yield points inside the critical section
+ *
+ * By default threads run freely, each drawing from its own seeded generator
+ * whether to yield or spin at every yield point: run under ThreadSanitizer
+ * to catch data races as well. With --serial a single thread runs at a time
+ * and at every yield point the next one is drawn from the round seed, so a
+ * seed always replays the same interleaving. A violation prints the round
+ * seed, to be replayed with --seed s --rounds 1, and exits non zero. Consumers
+ * stalled with producers done and values missing end the round as a loss.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void stress_yield(void);
+
+#define SLIST_SPSC_YIELD() stress_yield()
+
+#include "../slist_spsc_template.h"
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_SPSC_DECLARE_STATIC(uint32_t);
+SLIST_SPSC_DEFINE_STATIC(uint32_t)
+
+#define MAX_THREADS 32
+#define MAX_EMPTY_EVENTS 1024
+#define EMPTY UINT32_MAX
+#define STALL_LIMIT 100000
+
+static uint64_t random_next(uint64_t* state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+/*
+ * Schedule: yield points and the serial scheduler
+ */
+
+static int serial;
+static pthread_mutex_t turnLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t turnChanged = PTHREAD_COND_INITIALIZER;
+static unsigned turn;
+static unsigned threadCount;
+static int alive[MAX_THREADS];
+static uint64_t scheduleState;
+
+static __thread unsigned threadIndex;
+static __thread uint64_t threadState;
+
+/* Called with turnLock held */
+static void pass_turn(void)
+{
+	unsigned candidates[MAX_THREADS];
+	unsigned count = 0;
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		if (alive[i])
+		{
+			candidates[count++] = i;
+		}
+	}
+	if (count > 0)
+	{
+		turn = candidates[random_next(&scheduleState) % count];
+		pthread_cond_broadcast(&turnChanged);
+	}
+}
+
+static void wait_turn(void)
+{
+	while (turn != threadIndex)
+	{
+		pthread_cond_wait(&turnChanged, &turnLock);
+	}
+}
+
+static void stress_yield(void)
+{
+	if (serial)
+	{
+		pthread_mutex_lock(&turnLock);
+		pass_turn();
+		wait_turn();
+		pthread_mutex_unlock(&turnLock);
+		return;
+	}
+	uint64_t draw = random_next(&threadState);
+	if ((draw & 3) == 0)
+	{
+		sched_yield();
+	}
+	else if ((draw & 3) == 1)
+	{
+		for (volatile unsigned spin = (unsigned)(draw >> 8) % 256; spin > 0; spin--)
+		{
+		}
+	}
+}
+
+static void thread_begin(unsigned index, uint64_t seed)
+{
+	threadIndex = index;
+	threadState = seed * 0x9e3779b97f4a7c15ull + index + 1;
+	if (serial)
+	{
+		pthread_mutex_lock(&turnLock);
+		wait_turn();
+		pthread_mutex_unlock(&turnLock);
+	}
+}
+
+static void thread_end(void)
+{
+	if (serial)
+	{
+		pthread_mutex_lock(&turnLock);
+		alive[threadIndex] = 0;
+		pass_turn();
+		pthread_mutex_unlock(&turnLock);
+	}
+}
+
+/*
+ * History
+ */
+
+typedef struct {
+	int enqueue;
+	uint32_t value;
+	uint64_t invoked;
+	uint64_t returned;
+} sEvent;
+
+typedef struct {
+	pthread_t id;
+	unsigned index;
+	int producer;
+	uint32_t first;
+	sEvent* events;
+	size_t count;
+	size_t empties;
+	SLIST_NODE(uint32_t)* nodes;
+} sThread;
+
+static uint64_t historyClock;
+
+/*
+ * The clock, like every counter of the harness, is relaxed: read-modify-writes
+ * of a single variable are still totally ordered, but create no happens-before
+ * that would hide the races of the queue from ThreadSanitizer. The signal
+ * fences keep the compiler from moving the stamps across the operation.
+ */
+static uint64_t stamp(void)
+{
+	uint64_t now;
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	now = __atomic_add_fetch(&historyClock, 1, __ATOMIC_RELAXED);
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	return now;
+}
+
+static void record(sThread* thread, int enqueue, uint32_t value, uint64_t invoked)
+{
+	if (value == EMPTY && thread->empties++ >= MAX_EMPTY_EVENTS)
+	{
+		// Dropping read-only events keeps the rest of the history valid
+		return;
+	}
+	sEvent* event = &thread->events[thread->count++];
+	event->enqueue = enqueue;
+	event->value = value;
+	event->invoked = invoked;
+	event->returned = stamp();
+}
+
+static const char* check_history(sThread* threads, unsigned count, uint32_t values, int spuriousEmpty)
+{
+	const sEvent** enqueued = calloc(values, sizeof(*enqueued));
+	const sEvent** dequeued = calloc(values, sizeof(*dequeued));
+	const char* violation = NULL;
+	if (enqueued == NULL || dequeued == NULL)
+	{
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	for (unsigned t = 0; t < count && violation == NULL; t++)
+	{
+		for (size_t e = 0; e < threads[t].count; e++)
+		{
+			const sEvent* event = &threads[t].events[e];
+			if (event->value == EMPTY)
+			{
+				continue;
+			}
+			if (event->value >= values)
+			{
+				violation = "unknown value dequeued";
+			}
+			else if (event->enqueue)
+			{
+				enqueued[event->value] = event;
+			}
+			else if (dequeued[event->value] != NULL)
+			{
+				violation = "value dequeued twice";
+			}
+			else
+			{
+				dequeued[event->value] = event;
+			}
+		}
+	}
+	for (uint32_t v = 0; v < values && violation == NULL; v++)
+	{
+		if (enqueued[v] == NULL || dequeued[v] == NULL)
+		{
+			violation = "value lost";
+		}
+		else if (dequeued[v]->returned < enqueued[v]->invoked)
+		{
+			violation = "value dequeued before being enqueued";
+		}
+	}
+	for (uint32_t a = 0; a < values && violation == NULL; a++)
+	{
+		for (uint32_t b = 0; b < values; b++)
+		{
+			if (enqueued[a]->returned < enqueued[b]->invoked && dequeued[b]->returned < dequeued[a]->invoked)
+			{
+				violation = "values dequeued out of order";
+				break;
+			}
+		}
+	}
+	for (unsigned t = 0; t < count && violation == NULL; t++)
+	{
+		for (size_t e = 0; e < threads[t].count && violation == NULL; e++)
+		{
+			const sEvent* empty = &threads[t].events[e];
+			if (empty->value != EMPTY)
+			{
+				continue;
+			}
+			int present = 0;
+			int overlapping = 0;
+			for (uint32_t v = 0; v < values; v++)
+			{
+				present |= enqueued[v]->returned < empty->invoked && dequeued[v]->invoked > empty->returned;
+				overlapping |= enqueued[v]->invoked < empty->returned && enqueued[v]->returned > empty->invoked;
+			}
+			if (present && !(spuriousEmpty && overlapping))
+			{
+				violation = "empty pop while a value was in the queue";
+			}
+		}
+	}
+	free(enqueued);
+	free(dequeued);
+	return violation;
+}
+
+/*
+ * Targets
+ */
+
+static size_t opsPerThread;
+static uint32_t remaining;
+static unsigned producersRunning;
+static SLIST_SPSC(uint32_t) spscQueue;
+static SLIST_NODE(uint32_t)* lockedList;
+static pthread_mutex_t listLock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t roundSeed;
+
+/* Consumers give up once producers are done and nothing arrives: values lost */
+static int stalled(SLIST_NODE(uint32_t)* node, size_t* idle)
+{
+	if (node != NULL)
+	{
+		__atomic_sub_fetch(&remaining, 1, __ATOMIC_RELAXED);
+		*idle = 0;
+		return 0;
+	}
+	return __atomic_load_n(&producersRunning, __ATOMIC_RELAXED) == 0 && ++*idle > STALL_LIMIT;
+}
+
+static void* spsc_run(void* argument)
+{
+	sThread* thread = argument;
+	size_t idle = 0;
+	thread_begin(thread->index, roundSeed);
+	for (size_t i = 0; thread->producer && i < opsPerThread; i++)
+	{
+		uint64_t invoked = stamp();
+		SLIST_SPSC_PUSH(uint32_t, spscQueue, thread->nodes[i]);
+		record(thread, 1, thread->nodes[i].data, invoked);
+		stress_yield();
+	}
+	if (thread->producer)
+	{
+		__atomic_sub_fetch(&producersRunning, 1, __ATOMIC_RELAXED);
+	}
+	while (!thread->producer && __atomic_load_n(&remaining, __ATOMIC_RELAXED) > 0)
+	{
+		uint64_t invoked = stamp();
+		SLIST_NODE(uint32_t)* node = SLIST_SPSC_POP(uint32_t, spscQueue);
+		record(thread, 0, (node != NULL) ? node->data : EMPTY, invoked);
+		if (stalled(node, &idle))
+		{
+			break;
+		}
+		stress_yield();
+	}
+	thread_end();
+	return NULL;
+}
+
+static void list_lock(void)
+{
+	// A blocking lock would deadlock the serial scheduler
+	while (pthread_mutex_trylock(&listLock) != 0)
+	{
+		stress_yield();
+	}
+}
+
+static void* locked_run(void* argument)
+{
+	sThread* thread = argument;
+	size_t idle = 0;
+	thread_begin(thread->index, roundSeed);
+	for (size_t i = 0; thread->producer && i < opsPerThread; i++)
+	{
+		uint64_t invoked = stamp();
+		list_lock();
+		stress_yield();
+		SLIST_ADD_NODE(uint32_t, lockedList, thread->nodes[i]);
+		stress_yield();
+		pthread_mutex_unlock(&listLock);
+		record(thread, 1, thread->nodes[i].data, invoked);
+		stress_yield();
+	}
+	if (thread->producer)
+	{
+		__atomic_sub_fetch(&producersRunning, 1, __ATOMIC_RELAXED);
+	}
+	while (!thread->producer && __atomic_load_n(&remaining, __ATOMIC_RELAXED) > 0)
+	{
+		uint64_t invoked = stamp();
+		list_lock();
+		stress_yield();
+		SLIST_NODE(uint32_t)* node = SLIST_POP_NODE(uint32_t, lockedList);
+		pthread_mutex_unlock(&listLock);
+		record(thread, 0, (node != NULL) ? node->data : EMPTY, invoked);
+		if (stalled(node, &idle))
+		{
+			break;
+		}
+		stress_yield();
+	}
+	thread_end();
+	return NULL;
+}
+
+typedef struct {
+	const char* name;
+	void* (*run)(void* argument);
+	int spuriousEmpty;
+	int fixedPairs;
+} sTarget;
+
+static const sTarget targets[] = {
+	{ "spsc", spsc_run, 1, 1 },
+	{ "locked", locked_run, 0, 0 },
+};
+
+#define TARGETS (sizeof(targets) / sizeof(targets[0]))
+
+static const char* run_round(const sTarget* target, unsigned pairs, uint64_t* events)
+{
+	sThread threads[MAX_THREADS];
+	unsigned count = 2 * pairs;
+	uint32_t values = (uint32_t)(pairs * opsPerThread);
+	memset(threads, 0, sizeof(threads));
+	SLIST_SPSC_INIT(uint32_t, spscQueue);
+	lockedList = NULL;
+	remaining = values;
+	producersRunning = pairs;
+	historyClock = 0;
+	scheduleState = roundSeed * 0xbf58476d1ce4e5b9ull + 1;
+	threadCount = count;
+	for (unsigned i = 0; i < count; i++)
+	{
+		threads[i].index = i;
+		threads[i].producer = (i < pairs);
+		threads[i].first = (uint32_t)(i * opsPerThread);
+		threads[i].events = malloc((opsPerThread + MAX_EMPTY_EVENTS + values) * sizeof(sEvent));
+		threads[i].nodes = calloc(opsPerThread, sizeof(SLIST_NODE(uint32_t)));
+		if (threads[i].events == NULL || threads[i].nodes == NULL)
+		{
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+		for (size_t n = 0; n < opsPerThread; n++)
+		{
+			threads[i].nodes[n].data = threads[i].first + (uint32_t)n;
+		}
+		alive[i] = 1;
+	}
+	turn = (unsigned)(random_next(&scheduleState) % count);
+	for (unsigned i = 0; i < count; i++)
+	{
+		pthread_create(&threads[i].id, NULL, target->run, &threads[i]);
+	}
+	for (unsigned i = 0; i < count; i++)
+	{
+		pthread_join(threads[i].id, NULL);
+	}
+	const char* violation = check_history(threads, count, values, target->spuriousEmpty);
+	for (unsigned i = 0; i < count; i++)
+	{
+		*events += threads[i].count;
+		free(threads[i].events);
+		free(threads[i].nodes);
+	}
+	return violation;
+}
+
+static void usage(const char* program)
+{
+	fprintf(stderr, "usage: %s [--target spsc|locked|all] [--rounds n] [--ops n] [--threads n] [--seed s] [--serial]\n",
+		program);
+	exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+	const char* only = "all";
+	size_t rounds = 200;
+	unsigned pairs = 2;
+	uint64_t seed = 1;
+	opsPerThread = 200;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--target") == 0 && i + 1 < argc)
+		{
+			only = argv[++i];
+		}
+		else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc)
+		{
+			rounds = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc)
+		{
+			opsPerThread = strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			pairs = (unsigned)strtoul(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = strtoull(argv[++i], NULL, 0);
+		}
+		else if (strcmp(argv[i], "--serial") == 0)
+		{
+			serial = 1;
+		}
+		else
+		{
+			usage(argv[0]);
+		}
+	}
+	if (rounds == 0 || opsPerThread == 0 || pairs == 0 || 2 * pairs > MAX_THREADS)
+	{
+		usage(argv[0]);
+	}
+
+	int failed = 0;
+	printf("{\"stress\": \"slist\", \"mode\": \"%s\", \"seed\": %lu, \"rounds\": %lu, \"ops\": %lu, \"results\": [",
+		serial ? "serial" : "free", (unsigned long)seed, (unsigned long)rounds, (unsigned long)opsPerThread);
+	for (size_t t = 0, printed = 0; t < TARGETS; t++)
+	{
+		if (strcmp(only, "all") != 0 && strcmp(only, targets[t].name) != 0)
+		{
+			continue;
+		}
+		unsigned targetPairs = targets[t].fixedPairs ? 1 : pairs;
+		uint64_t events = 0;
+		size_t violations = 0;
+		for (size_t r = 0; r < rounds; r++)
+		{
+			roundSeed = seed + r;
+			const char* violation = run_round(&targets[t], targetPairs, &events);
+			if (violation != NULL)
+			{
+				fprintf(stderr, "%s: %s, replay with --target %s --seed %lu --rounds 1%s\n", targets[t].name,
+					violation, targets[t].name, (unsigned long)roundSeed, serial ? " --serial" : "");
+				violations++;
+			}
+		}
+		printf("%s\n    {\"target\": \"%s\", \"threads\": %u, \"events\": %lu, \"violations\": %lu}",
+			printed++ ? "," : "", targets[t].name, 2 * targetPairs, (unsigned long)events, (unsigned long)violations);
+		failed |= (violations != 0);
+	}
+	printf("\n]}\n");
+	return failed;
+}
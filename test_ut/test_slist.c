@@ -62,3 +62,37 @@ void test_WhenTwoElements_ForEachFindsThoseTwoElements(void)
 	}
 	TEST_ASSERT_EQUAL_MESSAGE(2, found/2, "Unexpected number of nodes found");
 }
+
+void test_WhenSameNodeAddedTwice_ListKeepsOneCopy(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(sTestType, list);
+	SLIST_NODE(sTestType) node1, node2;
+	SLIST_ADD_NODE(sTestType, list, node1);
+	SLIST_ADD_NODE(sTestType, list, node2);
+	// Act
+	SLIST_ADD_NODE(sTestType, list, node1);
+	SLIST_ADD_NODE(sTestType, list, node2);
+	// Assert
+	uint8_t found = 0;
+	SLIST_FOR_EACH_NODE_PTR(sTestType, list, node)
+	{
+		found++;
+		TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(2, found, "List became circular");
+	}
+	TEST_ASSERT_EQUAL_MESSAGE(2, found, "Unexpected number of nodes found");
+}
+
+void test_WhenPopping_NodesComeOutInFifoOrder(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(sTestType, list);
+	SLIST_NODE(sTestType) node1, node2;
+	SLIST_ADD_NODE(sTestType, list, node1);
+	SLIST_ADD_NODE(sTestType, list, node2);
+	// Act and assert
+	TEST_ASSERT_EQUAL_PTR(&node1, SLIST_POP_NODE(sTestType, list));
+	TEST_ASSERT_EQUAL_PTR(&node2, SLIST_POP_NODE(sTestType, list));
+	TEST_ASSERT_NULL(SLIST_POP_NODE(sTestType, list));
+	TEST_ASSERT_NULL(list);
+}
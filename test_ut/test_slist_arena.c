@@ -0,0 +1,137 @@
+#define _GNU_SOURCE
+
+#include "unity.h"
+#include "slist_arena_template.h"
+
+#include <stdint.h>
+
+
+typedef struct {
+	uint8_t bytes[1000];
+} sLarge;
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_STATIC(sLarge);
+SLIST_DEFINE_STATIC(sLarge);
+
+typedef uint64_t sLine;
+
+SLIST_DECLARE_LAYOUT_STATIC(sLine, SLIST_LAYOUT_ALIGNED);
+SLIST_DEFINE_STATIC(sLine);
+
+void test_WhenNodesAllocated_TheyAreAlignedAndContiguous(void)
+{
+	// Arrange
+	SLIST_CREATE_ARENA(arena, 4096, 0);
+	// Act
+	SLIST_NODE(uint32_t)* first = SLIST_ARENA_ALLOC(uint32_t, arena);
+	SLIST_NODE(uint32_t)* second = SLIST_ARENA_ALLOC(uint32_t, arena);
+	// Assert
+	TEST_ASSERT_NOT_NULL(first);
+	TEST_ASSERT_NOT_NULL(second);
+	TEST_ASSERT_EQUAL(0, (uintptr_t)first % SLIST_ARENA_ALIGNMENT);
+	TEST_ASSERT_EQUAL(SLIST_ARENA_ROUND_UP(sizeof(*first), SLIST_ARENA_ALIGNMENT),
+		(size_t)((char*)second - (char*)first));
+	SLIST_ARENA_DESTROY(arena);
+}
+
+void test_WhenNodesAreCacheAligned_ArenaKeepsTheirAlignment(void)
+{
+	// Arrange
+	SLIST_CREATE_ARENA(arena, 4096, 0);
+	// Act and assert: small nodes in between misalign the cursor, and
+	// enough allocations to span several chunks
+	for (int i = 0; i < 200; i++)
+	{
+		TEST_ASSERT_NOT_NULL(SLIST_ARENA_ALLOC(uint32_t, arena));
+		SLIST_NODE(sLine)* node = SLIST_ARENA_ALLOC(sLine, arena);
+		TEST_ASSERT_NOT_NULL(node);
+		TEST_ASSERT_EQUAL(0, (uintptr_t)node % SLIST_CACHE_LINE);
+	}
+	TEST_ASSERT_TRUE(SLIST_ARENA_BYTES(arena) > 4096);
+	SLIST_ARENA_DESTROY(arena);
+}
+
+void test_WhenChunkExhausted_NewChunkIsAdded(void)
+{
+	// Arrange
+	SLIST_CREATE_ARENA(arena, 4096, 0);
+	SLIST_CREATE_LIST(sLarge, list);
+	// Act
+	for (int i = 0; i < 10; i++)
+	{
+		SLIST_NODE(sLarge)* node = SLIST_ARENA_ALLOC(sLarge, arena);
+		TEST_ASSERT_NOT_NULL(node);
+		node->data.bytes[0] = (uint8_t)i;
+		node->next = list;
+		list = node;
+	}
+	// Assert
+	TEST_ASSERT_TRUE(SLIST_ARENA_BYTES(arena) >= 10 * sizeof(SLIST_NODE(sLarge)));
+	int expected = 10;
+	SLIST_FOR_EACH_NODE_PTR(sLarge, list, node)
+	{
+		TEST_ASSERT_EQUAL(--expected, node->data.bytes[0]);
+	}
+	SLIST_ARENA_DESTROY(arena);
+	TEST_ASSERT_EQUAL(0, SLIST_ARENA_BYTES(arena));
+}
+
+void test_WhenAllocationLargerThanChunk_ItStillFits(void)
+{
+	// Arrange
+	SLIST_CREATE_ARENA(arena, 256, 0);
+	// Act
+	SLIST_NODE(sLarge)* node = SLIST_ARENA_ALLOC(sLarge, arena);
+	// Assert
+	TEST_ASSERT_NOT_NULL(node);
+	node->data.bytes[sizeof(node->data.bytes) - 1] = 1;
+	SLIST_ARENA_DESTROY(arena);
+}
+
+void test_WhenArenaReset_ChunksAreReused(void)
+{
+	// Arrange
+	SLIST_CREATE_ARENA(arena, 4096, 0);
+	SLIST_NODE(uint32_t)* first = SLIST_ARENA_ALLOC(uint32_t, arena);
+	for (int i = 0; i < 1000; i++)
+	{
+		SLIST_ARENA_ALLOC(uint32_t, arena);
+	}
+	size_t bytes = SLIST_ARENA_BYTES(arena);
+	// Act
+	SLIST_ARENA_RESET(arena);
+	SLIST_NODE(uint32_t)* again = SLIST_ARENA_ALLOC(uint32_t, arena);
+	for (int i = 0; i < 1000; i++)
+	{
+		SLIST_ARENA_ALLOC(uint32_t, arena);
+	}
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(first, again);
+	TEST_ASSERT_EQUAL(bytes, SLIST_ARENA_BYTES(arena));
+	SLIST_ARENA_DESTROY(arena);
+}
+
+void test_WhenHugePagesRequested_NodesAreUsable(void)
+{
+	// Arrange
+	SLIST_CREATE_ARENA(arena, 4096, SLIST_ARENA_HUGEPAGES);
+	SLIST_CREATE_LIST(uint32_t, list);
+	// Act
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		SLIST_NODE(uint32_t)* node = SLIST_ARENA_ALLOC(uint32_t, arena);
+		TEST_ASSERT_NOT_NULL(node);
+		node->data = i;
+		SLIST_ADD_NODE_PTR(uint32_t, list, node);
+	}
+	// Assert
+	uint32_t expected = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+	{
+		TEST_ASSERT_EQUAL(expected++, node->data);
+	}
+	TEST_ASSERT_EQUAL(100, expected);
+	SLIST_ARENA_DESTROY(arena);
+}
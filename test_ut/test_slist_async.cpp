@@ -0,0 +1,227 @@
+/*
+ * Ceedling only builds C tests, this one is built with a C++20 compiler:
+ *
+ *	g++ -std=c++20 -I.. -I<unity>/src test_slist_async.cpp <runner> <unity>/src/unity.c
+ */
+
+#include "unity.h"
+#include "slist_async_template.h"
+
+#include <cstdint>
+#include <deque>
+#include <exception>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_ASYNC_DECLARE(uint32_t);
+
+/*
+ * Minimal task and single-threaded executor
+ */
+
+struct sTask
+{
+	struct promise_type
+	{
+		sTask get_return_object() { return sTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+	std::coroutine_handle<promise_type> handle;
+};
+
+class cExecutor
+{
+public:
+	struct sYield
+	{
+		cExecutor& executor;
+		bool await_ready() const { return false; }
+		void await_suspend(std::coroutine_handle<> handle) { executor.ready_.push_back(handle); }
+		void await_resume() const {}
+	};
+
+	~cExecutor()
+	{
+		for (std::coroutine_handle<> task : tasks_)
+		{
+			task.destroy();
+		}
+	}
+
+	void spawn(sTask task)
+	{
+		tasks_.push_back(task.handle);
+		ready_.push_back(task.handle);
+	}
+
+	sYield yield() { return sYield{*this}; }
+
+	void run()
+	{
+		while (!ready_.empty())
+		{
+			std::coroutine_handle<> next = ready_.front();
+			ready_.pop_front();
+			next.resume();
+		}
+	}
+
+	bool all_done() const
+	{
+		for (std::coroutine_handle<> task : tasks_)
+		{
+			if (!task.done())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	std::deque<std::coroutine_handle<>> ready_;
+	std::deque<std::coroutine_handle<>> tasks_;
+};
+
+static SLIST_NODE(uint32_t) nodes[8];
+static SLIST_NODE(uint32_t)* received[8];
+static size_t receivedCount;
+
+void setUp(void)
+{
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		nodes[i].data = i;
+		nodes[i].next = NULL;
+		received[i] = NULL;
+	}
+	receivedCount = 0;
+}
+
+static sTask consume(SLIST_ASYNC_QUEUE(uint32_t)& queue, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		received[receivedCount++] = co_await SLIST_ASYNC_POP(uint32_t, queue);
+	}
+}
+
+static sTask produce(cExecutor& executor, SLIST_ASYNC_QUEUE(uint32_t)& queue, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		SLIST_ASYNC_PUSH(uint32_t, queue, nodes[i]);
+		co_await executor.yield();
+	}
+}
+
+void test_WhenItemQueued_PopDoesNotSuspend(void)
+{
+	// Arrange
+	cExecutor executor;
+	SLIST_ASYNC_QUEUE(uint32_t) queue;
+	SLIST_ASYNC_PUSH(uint32_t, queue, nodes[0]);
+	SLIST_ASYNC_PUSH(uint32_t, queue, nodes[1]);
+	// Act
+	executor.spawn(consume(queue, 2));
+	executor.run();
+	// Assert
+	TEST_ASSERT_TRUE(executor.all_done());
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], received[0]);
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], received[1]);
+	TEST_ASSERT_NULL(SLIST_ASYNC_TRY_POP(uint32_t, queue));
+}
+
+void test_WhenConsumerWaits_PushResumesItWithTheNode(void)
+{
+	// Arrange
+	cExecutor executor;
+	SLIST_ASYNC_QUEUE(uint32_t) queue;
+	executor.spawn(consume(queue, 1));
+	executor.run();
+	TEST_ASSERT_EQUAL(1, SLIST_ASYNC_WAITING(uint32_t, queue));
+	TEST_ASSERT_FALSE(executor.all_done());
+	// Act
+	SLIST_ASYNC_PUSH(uint32_t, queue, nodes[3]);
+	// Assert
+	TEST_ASSERT_TRUE(executor.all_done());
+	TEST_ASSERT_EQUAL(0, SLIST_ASYNC_WAITING(uint32_t, queue));
+	TEST_ASSERT_EQUAL_PTR(&nodes[3], received[0]);
+	TEST_ASSERT_NULL(SLIST_ASYNC_TRY_POP(uint32_t, queue));
+}
+
+void test_WhenSeveralConsumersWait_TheyAreServedInOrder(void)
+{
+	// Arrange
+	cExecutor executor;
+	SLIST_ASYNC_QUEUE(uint32_t) queue;
+	for (int i = 0; i < 3; i++)
+	{
+		executor.spawn(consume(queue, 1));
+	}
+	executor.run();
+	TEST_ASSERT_EQUAL(3, SLIST_ASYNC_WAITING(uint32_t, queue));
+	// Act
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		SLIST_ASYNC_PUSH(uint32_t, queue, nodes[i]);
+	}
+	// Assert
+	TEST_ASSERT_TRUE(executor.all_done());
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		TEST_ASSERT_EQUAL_PTR(&nodes[i], received[i]);
+	}
+}
+
+void test_WhenProducerAndConsumersShareExecutor_AllItemsArriveInOrder(void)
+{
+	// Arrange
+	cExecutor executor;
+	SLIST_ASYNC_QUEUE(uint32_t) queue;
+	executor.spawn(consume(queue, 3));
+	executor.spawn(produce(executor, queue, 8));
+	executor.spawn(consume(queue, 5));
+	// Act
+	executor.run();
+	// Assert
+	TEST_ASSERT_TRUE(executor.all_done());
+	TEST_ASSERT_EQUAL(8, receivedCount);
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		TEST_ASSERT_EQUAL_PTR(&nodes[i], received[i]);
+	}
+	TEST_ASSERT_EQUAL(0, SLIST_ASYNC_WAITING(uint32_t, queue));
+}
+
+void test_WhenSuspendedConsumerIsDestroyed_PushGoesToTheNextOne(void)
+{
+	// Arrange
+	SLIST_ASYNC_QUEUE(uint32_t) queue;
+	sTask first = consume(queue, 1);
+	sTask second = consume(queue, 1);
+	sTask third = consume(queue, 1);
+	first.handle.resume();
+	second.handle.resume();
+	third.handle.resume();
+	TEST_ASSERT_EQUAL(3, SLIST_ASYNC_WAITING(uint32_t, queue));
+	// Act
+	second.handle.destroy();
+	SLIST_ASYNC_PUSH(uint32_t, queue, nodes[0]);
+	SLIST_ASYNC_PUSH(uint32_t, queue, nodes[1]);
+	SLIST_ASYNC_PUSH(uint32_t, queue, nodes[2]);
+	// Assert
+	TEST_ASSERT_TRUE(first.handle.done());
+	TEST_ASSERT_TRUE(third.handle.done());
+	TEST_ASSERT_EQUAL(2, receivedCount);
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], received[0]);
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], received[1]);
+	TEST_ASSERT_EQUAL(0, SLIST_ASYNC_WAITING(uint32_t, queue));
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], SLIST_ASYNC_TRY_POP(uint32_t, queue));
+	first.handle.destroy();
+	third.handle.destroy();
+}
@@ -0,0 +1,114 @@
+#include "unity.h"
+#include "slist_batch_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_BATCH_DECLARE_STATIC(uint32_t);
+SLIST_BATCH_DEFINE_STATIC(uint32_t);
+
+static SLIST_NODE(uint32_t) nodes[8];
+static uint32_t flushes;
+static uint32_t flushed[8];
+static uint32_t flushedCount;
+
+static void record(SLIST_NODE(uint32_t)* batch, size_t count, void* context)
+{
+	uint32_t found = 0;
+	flushes++;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, batch, node)
+	{
+		flushed[flushedCount++] = node->data;
+		found++;
+	}
+	TEST_ASSERT_EQUAL(count, found);
+	TEST_ASSERT_EQUAL_PTR(&flushes, context);
+}
+
+void setUp(void)
+{
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		nodes[i].data = i;
+	}
+	flushes = 0;
+	flushedCount = 0;
+}
+
+void test_WhenCountThresholdReached_BatchIsFlushedInOrder(void)
+{
+	// Arrange
+	SLIST_CREATE_BATCH(uint32_t, batch, 3, 0, 0, record, &flushes);
+	// Act
+	TEST_ASSERT_FALSE(SLIST_BATCH_ADD(uint32_t, batch, nodes[0], 4, 0));
+	TEST_ASSERT_FALSE(SLIST_BATCH_ADD(uint32_t, batch, nodes[1], 4, 0));
+	TEST_ASSERT_TRUE(SLIST_BATCH_ADD(uint32_t, batch, nodes[2], 4, 0));
+	// Assert
+	TEST_ASSERT_EQUAL(1, flushes);
+	TEST_ASSERT_EQUAL(3, flushedCount);
+	TEST_ASSERT_EQUAL(0, flushed[0]);
+	TEST_ASSERT_EQUAL(1, flushed[1]);
+	TEST_ASSERT_EQUAL(2, flushed[2]);
+	TEST_ASSERT_EQUAL(0, SLIST_BATCH_COUNT(batch));
+	TEST_ASSERT_EQUAL(0, SLIST_BATCH_BYTES(batch));
+}
+
+void test_WhenByteThresholdReached_BatchIsFlushed(void)
+{
+	// Arrange
+	SLIST_CREATE_BATCH(uint32_t, batch, 0, 100, 0, record, &flushes);
+	// Act
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[0], 60, 0);
+	TEST_ASSERT_EQUAL(60, SLIST_BATCH_BYTES(batch));
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[1], 40, 0);
+	// Assert
+	TEST_ASSERT_EQUAL(1, flushes);
+	TEST_ASSERT_EQUAL(2, flushedCount);
+}
+
+void test_WhenDeadlinePasses_PollFlushes(void)
+{
+	// Arrange
+	SLIST_CREATE_BATCH(uint32_t, batch, 0, 0, 10, record, &flushes);
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[0], 1, 100);
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[1], 1, 105);
+	// Act and assert
+	TEST_ASSERT_FALSE(SLIST_BATCH_POLL(uint32_t, batch, 109));
+	TEST_ASSERT_TRUE(SLIST_BATCH_POLL(uint32_t, batch, 110));
+	TEST_ASSERT_EQUAL(2, flushedCount);
+	TEST_ASSERT_FALSE(SLIST_BATCH_POLL(uint32_t, batch, 200));
+}
+
+void test_WhenAddingAfterDeadline_BatchIsFlushedWithNewNode(void)
+{
+	// Arrange
+	SLIST_CREATE_BATCH(uint32_t, batch, 0, 0, 10, record, &flushes);
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[0], 1, 0);
+	// Act
+	TEST_ASSERT_TRUE(SLIST_BATCH_ADD(uint32_t, batch, nodes[1], 1, 20));
+	// Assert
+	TEST_ASSERT_EQUAL(2, flushedCount);
+}
+
+void test_WhenClockWrapsAround_DelayIsStillMeasured(void)
+{
+	// Arrange
+	SLIST_CREATE_BATCH(uint32_t, batch, 0, 0, 10, record, &flushes);
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[0], 1, UINT64_MAX - 4);
+	// Act and assert
+	TEST_ASSERT_FALSE(SLIST_BATCH_POLL(uint32_t, batch, 4));
+	TEST_ASSERT_TRUE(SLIST_BATCH_POLL(uint32_t, batch, 5));
+}
+
+void test_WhenFlushedExplicitly_EmptyBatchIsNotHandedOver(void)
+{
+	// Arrange
+	SLIST_CREATE_BATCH(uint32_t, batch, 0, 0, 0, record, &flushes);
+	// Act and assert
+	TEST_ASSERT_FALSE(SLIST_BATCH_FLUSH(uint32_t, batch));
+	SLIST_BATCH_ADD(uint32_t, batch, nodes[0], 1, 0);
+	TEST_ASSERT_TRUE(SLIST_BATCH_FLUSH(uint32_t, batch));
+	TEST_ASSERT_EQUAL(1, flushes);
+}
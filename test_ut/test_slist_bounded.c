@@ -0,0 +1,146 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+#define QUEUE_LENGTH 3
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_BOUNDED_STATIC(uint32_t, QUEUE_LENGTH);
+SLIST_DEFINE_BOUNDED_STATIC(uint32_t, QUEUE_LENGTH);
+SLIST_DECLARE_BOUNDED_REORDER_STATIC(uint32_t, QUEUE_LENGTH);
+SLIST_DEFINE_BOUNDED_REORDER_STATIC(uint32_t, QUEUE_LENGTH);
+SLIST_BOUNDED_ASSERT_FITS(QUEUE_LENGTH, 8, poolFitsQueue);
+
+static SLIST_NODE(uint32_t) nodes[QUEUE_LENGTH + 1];
+
+void setUp(void)
+{
+	for (uint32_t i = 0; i < QUEUE_LENGTH + 1; i++)
+	{
+		nodes[i].data = i;
+	}
+}
+
+static void fill(SLIST_BOUNDED(uint32_t, QUEUE_LENGTH)* list)
+{
+	for (uint32_t i = 0; i < QUEUE_LENGTH; i++)
+	{
+		TEST_ASSERT_NULL(SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, *list, nodes[i]));
+	}
+}
+
+void test_WhenCreated_ListIsEmpty(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	// Act and assert
+	TEST_ASSERT_EQUAL(0, SLIST_BOUNDED_COUNT(list));
+	TEST_ASSERT_FALSE(SLIST_BOUNDED_IS_FULL(QUEUE_LENGTH, list));
+	TEST_ASSERT_NULL(SLIST_BOUNDED_POP(uint32_t, QUEUE_LENGTH, list));
+}
+
+void test_WhenFilled_ListIsFullAndKeepsOrder(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	// Act
+	fill(&list);
+	// Assert
+	TEST_ASSERT_EQUAL(QUEUE_LENGTH, SLIST_BOUNDED_COUNT(list));
+	TEST_ASSERT_TRUE(SLIST_BOUNDED_IS_FULL(QUEUE_LENGTH, list));
+	uint32_t expected = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, SLIST_BOUNDED_HEAD(list), node)
+	{
+		TEST_ASSERT_EQUAL(expected++, node->data);
+	}
+}
+
+void test_WhenFullAndDropNew_NewNodeIsRefused(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	fill(&list);
+	// Act
+	SLIST_NODE(uint32_t)* dropped = SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[QUEUE_LENGTH]);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[QUEUE_LENGTH], dropped);
+	TEST_ASSERT_EQUAL(QUEUE_LENGTH, SLIST_BOUNDED_COUNT(list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], SLIST_BOUNDED_HEAD(list));
+}
+
+void test_WhenFullAndDropOldest_HeadIsEvicted(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_OLDEST);
+	fill(&list);
+	// Act
+	SLIST_NODE(uint32_t)* dropped = SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[QUEUE_LENGTH]);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], dropped);
+	TEST_ASSERT_EQUAL(QUEUE_LENGTH, SLIST_BOUNDED_COUNT(list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], SLIST_BOUNDED_POP(uint32_t, QUEUE_LENGTH, list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], SLIST_BOUNDED_POP(uint32_t, QUEUE_LENGTH, list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[3], SLIST_BOUNDED_POP(uint32_t, QUEUE_LENGTH, list));
+	TEST_ASSERT_EQUAL(0, SLIST_BOUNDED_COUNT(list));
+}
+
+void test_WhenNodeRepeated_CountIsNotIncreased(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[0]);
+	// Act
+	SLIST_NODE(uint32_t)* dropped = SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[0]);
+	// Assert
+	TEST_ASSERT_NULL(dropped);
+	TEST_ASSERT_EQUAL(1, SLIST_BOUNDED_COUNT(list));
+}
+
+void test_WhenEmptiedAndRefilled_TailIsReset(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[0]);
+	SLIST_BOUNDED_POP(uint32_t, QUEUE_LENGTH, list);
+	// Act
+	SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[1]);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], SLIST_BOUNDED_HEAD(list));
+	TEST_ASSERT_NULL(nodes[1].next);
+}
+
+void test_WhenRotatedAndReversed_TailAndCountFollow(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	fill(&list);
+	// Act
+	SLIST_BOUNDED_ROTATE(uint32_t, QUEUE_LENGTH, list, QUEUE_LENGTH + 1);
+	SLIST_BOUNDED_REVERSE(uint32_t, QUEUE_LENGTH, list);
+	// Assert: 0 1 2 -> 1 2 0 -> 0 2 1
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], SLIST_BOUNDED_HEAD(list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], list.tail);
+	TEST_ASSERT_EQUAL(QUEUE_LENGTH, SLIST_BOUNDED_COUNT(list));
+	TEST_ASSERT_NULL(list.tail->next);
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], nodes[0].next);
+}
+
+void test_WhenSplit_ListKeepsHeadAndReturnsRest(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, QUEUE_LENGTH, list, SLIST_DROP_NEW);
+	fill(&list);
+	// Act
+	SLIST_NODE(uint32_t)* rest = SLIST_BOUNDED_SPLIT_AT(uint32_t, QUEUE_LENGTH, list, 1);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], rest);
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], rest->next);
+	TEST_ASSERT_EQUAL(1, SLIST_BOUNDED_COUNT(list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], list.tail);
+	TEST_ASSERT_NULL(SLIST_BOUNDED_ADD(uint32_t, QUEUE_LENGTH, list, nodes[3]));
+	TEST_ASSERT_EQUAL_PTR(&nodes[3], nodes[0].next);
+	TEST_ASSERT_NULL(SLIST_BOUNDED_SPLIT_AT(uint32_t, QUEUE_LENGTH, list, 2));
+}
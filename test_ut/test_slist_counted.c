@@ -0,0 +1,92 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_COUNTED_STATIC(uint32_t);
+SLIST_DEFINE_COUNTED_STATIC(uint32_t);
+
+static SLIST_NODE(uint32_t) nodes[6];
+
+void setUp(void)
+{
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		nodes[i].data = i;
+		nodes[i].next = NULL;
+	}
+}
+
+static size_t walk_length(SLIST_NODE(uint32_t)* head)
+{
+	size_t length = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, head, node)
+	{
+		length++;
+	}
+	return length;
+}
+
+void test_WhenNodesAddedAndPopped_SizeFollows(void)
+{
+	// Arrange
+	SLIST_CREATE_COUNTED_LIST(uint32_t, list);
+	TEST_ASSERT_EQUAL(0, SLIST_COUNTED_SIZE(list));
+	// Act
+	TEST_ASSERT_TRUE(SLIST_COUNTED_ADD(uint32_t, list, nodes[0]));
+	TEST_ASSERT_TRUE(SLIST_COUNTED_ADD(uint32_t, list, nodes[1]));
+	TEST_ASSERT_FALSE(SLIST_COUNTED_ADD(uint32_t, list, nodes[0]));
+	TEST_ASSERT_EQUAL(2, SLIST_COUNTED_SIZE(list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], SLIST_COUNTED_POP(uint32_t, list));
+	// Assert
+	TEST_ASSERT_EQUAL(1, SLIST_COUNTED_SIZE(list));
+	TEST_ASSERT_EQUAL(1, walk_length(SLIST_COUNTED_HEAD(list)));
+	SLIST_COUNTED_POP(uint32_t, list);
+	TEST_ASSERT_NULL(SLIST_COUNTED_POP(uint32_t, list));
+	TEST_ASSERT_EQUAL(0, SLIST_COUNTED_SIZE(list));
+}
+
+void test_WhenNodeRemoved_SizeDecreasesOnlyIfFound(void)
+{
+	// Arrange
+	SLIST_CREATE_COUNTED_LIST(uint32_t, list);
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		SLIST_COUNTED_ADD(uint32_t, list, nodes[i]);
+	}
+	// Act
+	TEST_ASSERT_TRUE(SLIST_COUNTED_REMOVE(uint32_t, list, nodes[1]));
+	TEST_ASSERT_FALSE(SLIST_COUNTED_REMOVE(uint32_t, list, nodes[1]));
+	TEST_ASSERT_TRUE(SLIST_COUNTED_REMOVE(uint32_t, list, nodes[0]));
+	// Assert
+	TEST_ASSERT_EQUAL(1, SLIST_COUNTED_SIZE(list));
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], SLIST_COUNTED_HEAD(list));
+	TEST_ASSERT_NULL(nodes[2].next);
+}
+
+void test_WhenListsSpliced_SizesAreMoved(void)
+{
+	// Arrange
+	SLIST_CREATE_COUNTED_LIST(uint32_t, list);
+	SLIST_CREATE_COUNTED_LIST(uint32_t, other);
+	SLIST_COUNTED_ADD(uint32_t, list, nodes[0]);
+	for (uint32_t i = 1; i < 4; i++)
+	{
+		SLIST_COUNTED_ADD(uint32_t, other, nodes[i]);
+	}
+	// Act
+	SLIST_COUNTED_SPLICE(uint32_t, list, other);
+	// Assert
+	TEST_ASSERT_EQUAL(4, SLIST_COUNTED_SIZE(list));
+	TEST_ASSERT_EQUAL(4, walk_length(SLIST_COUNTED_HEAD(list)));
+	TEST_ASSERT_EQUAL(0, SLIST_COUNTED_SIZE(other));
+	TEST_ASSERT_NULL(SLIST_COUNTED_HEAD(other));
+	uint32_t expected = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, SLIST_COUNTED_HEAD(list), node)
+	{
+		TEST_ASSERT_EQUAL(expected++, node->data);
+	}
+}
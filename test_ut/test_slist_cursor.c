@@ -0,0 +1,106 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_CURSOR_STATIC(uint32_t);
+SLIST_DEFINE_CURSOR_STATIC(uint32_t);
+
+static void assert_list(SLIST_NODE(uint32_t)* list, const uint32_t* expected, uint32_t count)
+{
+	uint32_t found = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+	{
+		TEST_ASSERT_LESS_THAN(count, found);
+		TEST_ASSERT_EQUAL(expected[found++], node->data);
+	}
+	TEST_ASSERT_EQUAL(count, found);
+}
+
+void test_WhenListIsEmpty_NextReturnsNull(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_CREATE_CURSOR(uint32_t, cursor, list);
+	// Act and assert
+	TEST_ASSERT_NULL(SLIST_CURSOR_NEXT(uint32_t, cursor));
+	TEST_ASSERT_NULL(SLIST_CURSOR_NODE_PTR(cursor));
+}
+
+void test_WhenEndReached_CursorResumesOnAppendedNodes(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_CREATE_CURSOR(uint32_t, cursor, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	TEST_ASSERT_EQUAL_PTR(&node1, SLIST_CURSOR_NEXT(uint32_t, cursor));
+	TEST_ASSERT_NULL(SLIST_CURSOR_NEXT(uint32_t, cursor));
+	// Act
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&node1, SLIST_CURSOR_NODE_PTR(cursor));
+	TEST_ASSERT_EQUAL_PTR(&node2, SLIST_CURSOR_NEXT(uint32_t, cursor));
+}
+
+void test_WhenInsertingAfterCursor_NodesAreLinkedInPlace(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_CREATE_CURSOR(uint32_t, cursor, list);
+	SLIST_NODE(uint32_t) node0, node1, node2, node3;
+	node0.data = 0;
+	node1.data = 1;
+	node2.data = 2;
+	node3.data = 3;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node3);
+	// Act
+	SLIST_CURSOR_INSERT_AFTER(uint32_t, cursor, node0);
+	SLIST_CURSOR_NEXT(uint32_t, cursor);
+	SLIST_CURSOR_NEXT(uint32_t, cursor);
+	SLIST_CURSOR_INSERT_AFTER(uint32_t, cursor, node2);
+	// Assert
+	assert_list(list, (const uint32_t[]){ 0, 1, 2, 3 }, 4);
+	TEST_ASSERT_EQUAL_PTR(&node2, SLIST_CURSOR_NEXT(uint32_t, cursor));
+}
+
+void test_WhenRemovingAfterCursor_NextNodeIsUnlinked(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_CREATE_CURSOR(uint32_t, cursor, list);
+	SLIST_NODE(uint32_t) node1, node2, node3;
+	node1.data = 1;
+	node2.data = 2;
+	node3.data = 3;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	SLIST_ADD_NODE(uint32_t, list, node3);
+	// Act and assert
+	TEST_ASSERT_EQUAL_PTR(&node1, SLIST_CURSOR_REMOVE_AFTER(uint32_t, cursor));
+	assert_list(list, (const uint32_t[]){ 2, 3 }, 2);
+	SLIST_CURSOR_NEXT(uint32_t, cursor);
+	TEST_ASSERT_EQUAL_PTR(&node3, SLIST_CURSOR_REMOVE_AFTER(uint32_t, cursor));
+	assert_list(list, (const uint32_t[]){ 2 }, 1);
+	TEST_ASSERT_NULL(SLIST_CURSOR_REMOVE_AFTER(uint32_t, cursor));
+}
+
+void test_WhenReset_CursorStartsOverFromHead(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_CREATE_CURSOR(uint32_t, cursor, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	SLIST_CURSOR_NEXT(uint32_t, cursor);
+	SLIST_CURSOR_NEXT(uint32_t, cursor);
+	// Act
+	SLIST_CURSOR_RESET(cursor);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&node1, SLIST_CURSOR_NEXT(uint32_t, cursor));
+}
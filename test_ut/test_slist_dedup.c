@@ -0,0 +1,111 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_DEDUP_STATIC(uint32_t);
+SLIST_DEFINE_DEDUP_STATIC(uint32_t);
+
+static size_t hash_u32(const uint32_t* data)
+{
+	return *data * 2654435761u;
+}
+
+static size_t hash_constant(const uint32_t* data)
+{
+	(void)data;
+	return 7;
+}
+
+static int eq_u32(const uint32_t* a, const uint32_t* b)
+{
+	return *a == *b;
+}
+
+static void fill(SLIST_NODE(uint32_t)** list, SLIST_NODE(uint32_t)* nodes, const uint32_t* values, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		nodes[i].data = values[i];
+		SLIST_ADD_NODE_PTR(uint32_t, *list, &nodes[i]);
+	}
+}
+
+static void assert_list(SLIST_NODE(uint32_t)* list, const uint32_t* expected, size_t count)
+{
+	size_t at = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+	{
+		TEST_ASSERT_TRUE(at < count);
+		TEST_ASSERT_EQUAL(expected[at++], node->data);
+	}
+	TEST_ASSERT_EQUAL(count, at);
+}
+
+void test_WhenValuesRepeated_FirstOccurrencesAreKeptInOrder(void)
+{
+	// Arrange
+	static const uint32_t values[] = { 5, 3, 5, 1, 3, 3, 9, 1 };
+	SLIST_NODE(uint32_t) nodes[8];
+	SLIST_NODE(uint32_t)* slots[16];
+	SLIST_CREATE_LIST(uint32_t, list);
+	fill(&list, nodes, values, 8);
+	// Act
+	SLIST_NODE(uint32_t)* removed = SLIST_DEDUP(uint32_t, list, hash_u32, eq_u32, slots, 16);
+	// Assert
+	static const uint32_t kept[] = { 5, 3, 1, 9 };
+	static const uint32_t dropped[] = { 5, 3, 3, 1 };
+	assert_list(list, kept, 4);
+	assert_list(removed, dropped, 4);
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], list);
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], removed);
+}
+
+void test_WhenHashesCollide_OnlyEqualValuesAreRemoved(void)
+{
+	// Arrange
+	static const uint32_t values[] = { 1, 2, 1, 3, 2 };
+	SLIST_NODE(uint32_t) nodes[5];
+	SLIST_NODE(uint32_t)* slots[5];
+	SLIST_CREATE_LIST(uint32_t, list);
+	fill(&list, nodes, values, 5);
+	// Act
+	SLIST_DEDUP(uint32_t, list, hash_constant, eq_u32, slots, 5);
+	// Assert
+	static const uint32_t kept[] = { 1, 2, 3 };
+	assert_list(list, kept, 3);
+}
+
+void test_WhenSetTooSmall_UnrecordedValuesAreKept(void)
+{
+	// Arrange
+	static const uint32_t values[] = { 1, 2, 2, 1 };
+	SLIST_NODE(uint32_t) nodes[4];
+	SLIST_NODE(uint32_t)* slots[1];
+	SLIST_CREATE_LIST(uint32_t, list);
+	fill(&list, nodes, values, 4);
+	// Act
+	SLIST_NODE(uint32_t)* removed = SLIST_DEDUP(uint32_t, list, hash_u32, eq_u32, slots, 1);
+	// Assert
+	static const uint32_t kept[] = { 1, 2, 2 };
+	assert_list(list, kept, 3);
+	TEST_ASSERT_EQUAL_PTR(&nodes[3], removed);
+}
+
+void test_WhenAllValuesEqual_OnlyTheFirstRemains(void)
+{
+	// Arrange
+	static const uint32_t values[] = { 4, 4, 4 };
+	SLIST_NODE(uint32_t) nodes[3];
+	SLIST_NODE(uint32_t)* slots[4];
+	SLIST_CREATE_LIST(uint32_t, list);
+	fill(&list, nodes, values, 3);
+	// Act
+	SLIST_DEDUP(uint32_t, list, hash_u32, eq_u32, slots, 4);
+	// Assert
+	assert_list(list, values, 1);
+	TEST_ASSERT_NULL(SLIST_DEDUP(uint32_t, list, hash_u32, eq_u32, slots, 4));
+}
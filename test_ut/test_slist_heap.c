@@ -0,0 +1,103 @@
+#include "unity.h"
+#include "slist_heap_template.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+typedef struct {
+	uint64_t deadline;
+	uint32_t id;
+} sTimer;
+
+#define TIMER_LESS(a, b) ((a)->deadline < (b)->deadline)
+
+SLIST_DECLARE_STATIC(sTimer);
+SLIST_DEFINE_STATIC(sTimer);
+SLIST_HEAP_DECLARE_STATIC(sTimer);
+SLIST_HEAP_DEFINE_STATIC(sTimer, TIMER_LESS);
+
+#define TIMERS 200
+
+static SLIST_HEAP_NODE(sTimer) timers[TIMERS];
+
+void test_WhenEmpty_PopReturnsNull(void)
+{
+	// Arrange
+	SLIST_CREATE_HEAP(sTimer, heap);
+	// Act and assert
+	TEST_ASSERT_TRUE(SLIST_HEAP_IS_EMPTY(heap));
+	TEST_ASSERT_NULL(SLIST_HEAP_PEEK(heap));
+	TEST_ASSERT_NULL(SLIST_HEAP_POP_MIN(sTimer, heap));
+}
+
+void test_WhenRandomDeadlinesInserted_TheyArePoppedInOrder(void)
+{
+	// Arrange
+	SLIST_CREATE_HEAP(sTimer, heap);
+	srand(7);
+	for (uint32_t i = 0; i < TIMERS; i++)
+	{
+		timers[i].link.data.deadline = (uint64_t)(rand() % 50) << 40;
+		SLIST_HEAP_INSERT(sTimer, heap, timers[i]);
+	}
+	TEST_ASSERT_EQUAL(TIMERS, SLIST_HEAP_COUNT(heap));
+	// Act and assert
+	uint64_t last = 0;
+	for (uint32_t i = 0; i < TIMERS; i++)
+	{
+		TEST_ASSERT_EQUAL_PTR(SLIST_HEAP_PEEK(heap), SLIST_HEAP_PEEK(heap));
+		SLIST_HEAP_NODE(sTimer)* timer = SLIST_HEAP_POP_MIN(sTimer, heap);
+		TEST_ASSERT_NOT_NULL(timer);
+		TEST_ASSERT_TRUE(timer->link.data.deadline >= last);
+		last = timer->link.data.deadline;
+	}
+	TEST_ASSERT_TRUE(SLIST_HEAP_IS_EMPTY(heap));
+	TEST_ASSERT_EQUAL(0, SLIST_HEAP_COUNT(heap));
+}
+
+void test_WhenHeapsMelded_AllNodesComeOutInOrder(void)
+{
+	// Arrange
+	SLIST_CREATE_HEAP(sTimer, even);
+	SLIST_CREATE_HEAP(sTimer, odd);
+	for (uint32_t i = 0; i < 10; i++)
+	{
+		timers[i].link.data.deadline = 10 - i;
+		if (i % 2)
+		{
+			SLIST_HEAP_INSERT(sTimer, odd, timers[i]);
+		}
+		else
+		{
+			SLIST_HEAP_INSERT(sTimer, even, timers[i]);
+		}
+	}
+	// Act
+	SLIST_HEAP_MELD(sTimer, even, odd);
+	// Assert
+	TEST_ASSERT_TRUE(SLIST_HEAP_IS_EMPTY(odd));
+	TEST_ASSERT_EQUAL(10, SLIST_HEAP_COUNT(even));
+	for (uint64_t deadline = 1; deadline <= 10; deadline++)
+	{
+		TEST_ASSERT_EQUAL(deadline, SLIST_HEAP_POP_MIN(sTimer, even)->link.data.deadline);
+	}
+}
+
+void test_WhenPopped_NodeCanBeAddedToAList(void)
+{
+	// Arrange
+	SLIST_CREATE_HEAP(sTimer, heap);
+	SLIST_CREATE_LIST(sTimer, expired);
+	timers[0].link.data.deadline = 2;
+	timers[1].link.data.deadline = 1;
+	SLIST_HEAP_INSERT(sTimer, heap, timers[0]);
+	SLIST_HEAP_INSERT(sTimer, heap, timers[1]);
+	// Act
+	SLIST_ADD_NODE(sTimer, expired, SLIST_HEAP_POP_MIN(sTimer, heap)->link);
+	SLIST_ADD_NODE(sTimer, expired, SLIST_HEAP_POP_MIN(sTimer, heap)->link);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&timers[1].link, expired);
+	TEST_ASSERT_EQUAL_PTR(&timers[0].link, expired->next);
+	TEST_ASSERT_NULL(expired->next->next);
+}
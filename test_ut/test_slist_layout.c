@@ -0,0 +1,99 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+typedef struct {
+	uint8_t bytes[200];
+} sNextFirst;
+
+typedef struct {
+	uint8_t bytes[100];
+} sAligned;
+
+typedef struct {
+	uint8_t bytes[3];
+} sPacked;
+
+SLIST_DECLARE_LAYOUT_STATIC(sNextFirst, SLIST_LAYOUT_NEXT_FIRST);
+SLIST_DEFINE_STATIC(sNextFirst);
+SLIST_DECLARE_LAYOUT_STATIC(sAligned, SLIST_LAYOUT_ALIGNED);
+SLIST_DEFINE_STATIC(sAligned);
+SLIST_DECLARE_LAYOUT_STATIC(sPacked, SLIST_LAYOUT_PACKED);
+SLIST_DEFINE_STATIC(sPacked);
+SLIST_DECLARE_CURSOR_STATIC(sPacked);
+SLIST_DEFINE_CURSOR_STATIC(sPacked);
+SLIST_DECLARE_LAYOUT_STATIC(uint32_t, SLIST_LAYOUT_DEFAULT);
+SLIST_DEFINE_STATIC(uint32_t);
+
+SLIST_ASSERT_NODE_LAYOUT(sPacked, sizeof(sPacked) + sizeof(void*), 0);
+SLIST_ASSERT_NODE_LAYOUT(sNextFirst, 256, sizeof(void*));
+
+void test_WhenNextFirst_NextIsAtOffsetZero(void)
+{
+	// Assert
+	TEST_ASSERT_EQUAL(0, SLIST_NODE_NEXT_OFFSET(sNextFirst));
+	TEST_ASSERT_EQUAL(sizeof(uint32_t) + SLIST_NODE_PADDING(uint32_t), SLIST_NODE_NEXT_OFFSET(uint32_t));
+}
+
+void test_WhenAligned_NodesFillWholeCacheLines(void)
+{
+	// Arrange
+	SLIST_NODE(sAligned) nodes[3];
+	// Assert
+	TEST_ASSERT_EQUAL(0, SLIST_NODE_NEXT_OFFSET(sAligned));
+	TEST_ASSERT_EQUAL(0, SLIST_NODE_SIZE(sAligned) % SLIST_CACHE_LINE);
+	TEST_ASSERT_EQUAL(0, (uintptr_t)&nodes[1] % SLIST_CACHE_LINE);
+}
+
+void test_WhenPacked_NodeHasNoPadding(void)
+{
+	// Assert
+	TEST_ASSERT_EQUAL(0, SLIST_NODE_PADDING(sPacked));
+	TEST_ASSERT_EQUAL(sizeof(sPacked), SLIST_NODE_NEXT_OFFSET(sPacked));
+}
+
+void test_WhenPacked_ListOperationsStillWork(void)
+{
+	// Arrange
+	SLIST_NODE(sPacked) nodes[4];
+	SLIST_CREATE_LIST(sPacked, list);
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		nodes[i].data.bytes[0] = i;
+		SLIST_ADD_NODE(sPacked, list, nodes[i]);
+	}
+	SLIST_ADD_NODE(sPacked, list, nodes[1]);
+	// Act
+	SLIST_CREATE_CURSOR(sPacked, cursor, list);
+	SLIST_CURSOR_NEXT(sPacked, cursor);
+	nodes[3].data.bytes[0] = 9;
+	SLIST_CURSOR_INSERT_AFTER(sPacked, cursor, nodes[3]);
+	SLIST_NODE(sPacked)* removed = SLIST_CURSOR_REMOVE_AFTER(sPacked, cursor);
+	SLIST_NODE(sPacked)* popped = SLIST_POP_NODE(sPacked, list);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[3], removed);
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], popped);
+	uint8_t expected = 1;
+	SLIST_FOR_EACH_NODE_PTR(sPacked, list, node)
+	{
+		TEST_ASSERT_EQUAL(expected++, node->data.bytes[0]);
+	}
+	TEST_ASSERT_EQUAL(3, expected);
+}
+
+void test_WhenPaddedListsInArray_EachHeadHasItsOwnCacheLine(void)
+{
+	// Arrange
+	SLIST_PADDED_LIST(uint32_t) lists[2] = { { NULL, { 0 } }, { NULL, { 0 } } };
+	SLIST_NODE(uint32_t) node;
+	node.data = 7;
+	// Act
+	SLIST_ADD_NODE(uint32_t, SLIST_PADDED_HEAD(lists[1]), node);
+	// Assert
+	TEST_ASSERT_EQUAL(SLIST_CACHE_LINE, (uintptr_t)&lists[1] - (uintptr_t)&lists[0]);
+	TEST_ASSERT_EQUAL(0, (uintptr_t)&lists[0] % SLIST_CACHE_LINE);
+	TEST_ASSERT_NULL(SLIST_PADDED_HEAD(lists[0]));
+	TEST_ASSERT_EQUAL_PTR(&node, SLIST_POP_NODE(uint32_t, SLIST_PADDED_HEAD(lists[1])));
+}
@@ -0,0 +1,119 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+typedef struct {
+	uint32_t key;
+	uint32_t source;
+} sEvent;
+
+SLIST_DECLARE_STATIC(sEvent);
+SLIST_DEFINE_STATIC(sEvent);
+SLIST_DECLARE_MERGE_STATIC(sEvent);
+SLIST_DEFINE_MERGE_STATIC(sEvent);
+
+static int by_key(const sEvent* a, const sEvent* b)
+{
+	return a->key < b->key;
+}
+
+static SLIST_NODE(sEvent)* fill(SLIST_NODE(sEvent)* nodes, const uint32_t* keys, size_t count, uint32_t source)
+{
+	SLIST_CREATE_LIST(sEvent, list);
+	for (size_t i = 0; i < count; i++)
+	{
+		nodes[i].data.key = keys[i];
+		nodes[i].data.source = source;
+		SLIST_ADD_NODE_PTR(sEvent, list, &nodes[i]);
+	}
+	return list;
+}
+
+static size_t assert_sorted_and_stable(SLIST_NODE(sEvent)* list)
+{
+	size_t count = 0;
+	SLIST_NODE(sEvent)* previous = NULL;
+	SLIST_FOR_EACH_NODE_PTR(sEvent, list, node)
+	{
+		if (previous != NULL)
+		{
+			TEST_ASSERT_TRUE(previous->data.key <= node->data.key);
+			if (previous->data.key == node->data.key)
+			{
+				TEST_ASSERT_TRUE(previous->data.source <= node->data.source);
+			}
+		}
+		previous = node;
+		count++;
+	}
+	return count;
+}
+
+void test_WhenTwoListsMerged_ResultIsSortedAndStable(void)
+{
+	// Arrange
+	static const uint32_t keysA[] = { 1, 3, 3, 7 };
+	static const uint32_t keysB[] = { 0, 3, 8, 9 };
+	SLIST_NODE(sEvent) nodesA[4];
+	SLIST_NODE(sEvent) nodesB[4];
+	SLIST_NODE(sEvent)* a = fill(nodesA, keysA, 4, 0);
+	SLIST_NODE(sEvent)* b = fill(nodesB, keysB, 4, 1);
+	// Act
+	SLIST_NODE(sEvent)* merged = SLIST_MERGE(sEvent, a, b, by_key);
+	// Assert
+	TEST_ASSERT_EQUAL(8, assert_sorted_and_stable(merged));
+	TEST_ASSERT_EQUAL_PTR(&nodesB[0], merged);
+	TEST_ASSERT_EQUAL_PTR(&nodesB[3], nodesB[2].next);
+}
+
+void test_WhenOneListEmpty_MergeReturnsTheOther(void)
+{
+	// Arrange
+	static const uint32_t keys[] = { 2, 4 };
+	SLIST_NODE(sEvent) nodes[2];
+	SLIST_NODE(sEvent)* a = fill(nodes, keys, 2, 0);
+	// Act / Assert
+	TEST_ASSERT_EQUAL_PTR(a, SLIST_MERGE(sEvent, a, NULL, by_key));
+	TEST_ASSERT_EQUAL_PTR(a, SLIST_MERGE(sEvent, NULL, a, by_key));
+	TEST_ASSERT_NULL(SLIST_MERGE(sEvent, NULL, NULL, by_key));
+}
+
+void test_WhenKListsMerged_ResultIsSortedAndStable(void)
+{
+	// Arrange
+	static const uint32_t keys0[] = { 5, 5, 6 };
+	static const uint32_t keys2[] = { 1, 5, 9, 10 };
+	static const uint32_t keys3[] = { 5 };
+	static const uint32_t keys4[] = { 0, 2, 5, 11 };
+	SLIST_NODE(sEvent) nodes0[3];
+	SLIST_NODE(sEvent) nodes2[4];
+	SLIST_NODE(sEvent) nodes3[1];
+	SLIST_NODE(sEvent) nodes4[4];
+	SLIST_NODE(sEvent)* lists[5];
+	size_t heap[5];
+	lists[0] = fill(nodes0, keys0, 3, 0);
+	lists[1] = NULL;
+	lists[2] = fill(nodes2, keys2, 4, 2);
+	lists[3] = fill(nodes3, keys3, 1, 3);
+	lists[4] = fill(nodes4, keys4, 4, 4);
+	// Act
+	SLIST_NODE(sEvent)* merged = SLIST_MERGE_K(sEvent, lists, 5, by_key, heap);
+	// Assert
+	TEST_ASSERT_EQUAL(12, assert_sorted_and_stable(merged));
+	for (size_t i = 0; i < 5; i++)
+	{
+		TEST_ASSERT_NULL(lists[i]);
+	}
+}
+
+void test_WhenNoListsToMerge_ResultIsEmpty(void)
+{
+	// Arrange
+	SLIST_NODE(sEvent)* lists[2] = { NULL, NULL };
+	size_t heap[2];
+	// Act / Assert
+	TEST_ASSERT_NULL(SLIST_MERGE_K(sEvent, lists, 2, by_key, heap));
+	TEST_ASSERT_NULL(SLIST_MERGE_K(sEvent, lists, 0, by_key, heap));
+}
@@ -0,0 +1,95 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_PARTITION_STATIC(uint32_t);
+SLIST_DEFINE_PARTITION_STATIC(uint32_t);
+
+static size_t by_remainder(const uint32_t* data, void* context)
+{
+	return *data % *(const uint32_t*)context;
+}
+
+static void fill(SLIST_NODE(uint32_t)** list, SLIST_NODE(uint32_t)* nodes, uint32_t first, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		nodes[i].data = first + i;
+		SLIST_ADD_NODE_PTR(uint32_t, *list, &nodes[i]);
+	}
+}
+
+void test_WhenPartitioned_EveryListKeepsTheOriginalOrder(void)
+{
+	// Arrange
+	SLIST_NODE(uint32_t) nodes[10];
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t)* lists[3] = { NULL, NULL, NULL };
+	uint32_t k = 3;
+	fill(&list, nodes, 0, 10);
+	// Act
+	size_t moved = SLIST_PARTITION(uint32_t, list, lists, 3, by_remainder, &k);
+	// Assert
+	TEST_ASSERT_EQUAL(10, moved);
+	TEST_ASSERT_NULL(list);
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		uint32_t expected = i;
+		SLIST_FOR_EACH_NODE_PTR(uint32_t, lists[i], node)
+		{
+			TEST_ASSERT_EQUAL(expected, node->data);
+			expected += 3;
+		}
+		TEST_ASSERT_TRUE(expected >= 10);
+	}
+}
+
+void test_WhenClassifiedOutOfRange_NodesStayOnSource(void)
+{
+	// Arrange
+	SLIST_NODE(uint32_t) nodes[6];
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t)* lists[2] = { NULL, NULL };
+	uint32_t k = 4;
+	fill(&list, nodes, 0, 6);
+	// Act
+	size_t moved = SLIST_PARTITION(uint32_t, list, lists, 2, by_remainder, &k);
+	// Assert
+	TEST_ASSERT_EQUAL(4, moved);
+	uint32_t expected[] = { 2, 3 };
+	uint32_t at = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+	{
+		TEST_ASSERT_EQUAL(expected[at++], node->data);
+	}
+	TEST_ASSERT_EQUAL(2, at);
+}
+
+void test_WhenDestinationsNotEmpty_NodesAreAppended(void)
+{
+	// Arrange
+	SLIST_NODE(uint32_t) nodes[4];
+	SLIST_NODE(uint32_t) old[2];
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t)* lists[2] = { NULL, NULL };
+	uint32_t k = 2;
+	fill(&lists[0], old, 100, 2);
+	fill(&list, nodes, 0, 4);
+	// Act
+	SLIST_PARTITION(uint32_t, list, lists, 2, by_remainder, &k);
+	// Assert
+	uint32_t expected[] = { 100, 101, 0, 2 };
+	uint32_t at = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, lists[0], node)
+	{
+		TEST_ASSERT_EQUAL(expected[at++], node->data);
+	}
+	TEST_ASSERT_EQUAL(4, at);
+	TEST_ASSERT_EQUAL(1, lists[1]->data);
+	TEST_ASSERT_EQUAL(3, lists[1]->next->data);
+	TEST_ASSERT_NULL(lists[1]->next->next);
+}
@@ -0,0 +1,159 @@
+#include "unity.h"
+#include "slist_pool_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_POOL_DECLARE_STATIC(uint32_t);
+SLIST_POOL_DEFINE_STATIC(uint32_t);
+
+void test_WhenPoolExhausted_AllocReturnsInvalidHandle(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 2);
+	SLIST_POOL_ALLOC(uint32_t, pool);
+	SLIST_POOL_ALLOC(uint32_t, pool);
+	// Act
+	SLIST_HANDLE(uint32_t) handle = SLIST_POOL_ALLOC(uint32_t, pool);
+	// Assert
+	TEST_ASSERT_FALSE(SLIST_POOL_IS_VALID(uint32_t, pool, handle));
+	TEST_ASSERT_NULL(SLIST_POOL_LOOKUP(uint32_t, pool, handle));
+}
+
+void test_WhenNodeFreed_HandleBecomesStale(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 1);
+	SLIST_HANDLE(uint32_t) first = SLIST_POOL_ALLOC(uint32_t, pool);
+	TEST_ASSERT_TRUE(SLIST_POOL_IS_VALID(uint32_t, pool, first));
+	// Act
+	TEST_ASSERT_TRUE(SLIST_POOL_FREE(uint32_t, pool, first));
+	SLIST_HANDLE(uint32_t) second = SLIST_POOL_ALLOC(uint32_t, pool);
+	// Assert
+	TEST_ASSERT_EQUAL(first.index, second.index);
+	TEST_ASSERT_FALSE(SLIST_POOL_IS_VALID(uint32_t, pool, first));
+	TEST_ASSERT_TRUE(SLIST_POOL_IS_VALID(uint32_t, pool, second));
+	TEST_ASSERT_FALSE(SLIST_POOL_FREE(uint32_t, pool, first));
+}
+
+void test_WhenNodesAddedByHandle_ListKeepsFifoOrder(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 4);
+	SLIST_CREATE_LIST(uint32_t, list);
+	// Act
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		SLIST_HANDLE(uint32_t) handle = SLIST_POOL_ALLOC(uint32_t, pool);
+		SLIST_POOL_LOOKUP(uint32_t, pool, handle)->data = i;
+		TEST_ASSERT_TRUE(SLIST_POOL_ADD(uint32_t, pool, list, handle));
+		TEST_ASSERT_FALSE(SLIST_POOL_ADD(uint32_t, pool, list, handle));
+	}
+	// Assert
+	uint32_t expected = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+	{
+		TEST_ASSERT_EQUAL(expected++, node->data);
+	}
+	TEST_ASSERT_EQUAL(3, expected);
+}
+
+static void assert_list(SLIST_NODE(uint32_t)* list, const uint32_t* expected, uint32_t count)
+{
+	uint32_t found = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+	{
+		TEST_ASSERT_LESS_THAN(count, found);
+		TEST_ASSERT_EQUAL(expected[found++], node->data);
+	}
+	TEST_ASSERT_EQUAL(count, found);
+}
+
+void test_WhenRemovedByHandle_HeadMiddleAndTailAreUnlinked(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 5);
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_HANDLE(uint32_t) handles[5];
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		handles[i] = SLIST_POOL_ALLOC(uint32_t, pool);
+		SLIST_POOL_LOOKUP(uint32_t, pool, handles[i])->data = i;
+		SLIST_POOL_ADD(uint32_t, pool, list, handles[i]);
+	}
+	// Act and assert
+	TEST_ASSERT_TRUE(SLIST_POOL_REMOVE(uint32_t, pool, list, handles[2]));
+	assert_list(list, (const uint32_t[]){ 0, 1, 3, 4 }, 4);
+	TEST_ASSERT_TRUE(SLIST_POOL_REMOVE(uint32_t, pool, list, handles[0]));
+	assert_list(list, (const uint32_t[]){ 1, 3, 4 }, 3);
+	TEST_ASSERT_TRUE(SLIST_POOL_REMOVE(uint32_t, pool, list, handles[4]));
+	assert_list(list, (const uint32_t[]){ 1, 3 }, 2);
+	TEST_ASSERT_TRUE(SLIST_POOL_REMOVE(uint32_t, pool, list, handles[3]));
+	assert_list(list, (const uint32_t[]){ 1 }, 1);
+	TEST_ASSERT_TRUE(SLIST_POOL_REMOVE(uint32_t, pool, list, handles[1]));
+	TEST_ASSERT_NULL(list);
+}
+
+void test_WhenHandleIsStale_RemoveHasNoEffect(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 2);
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_HANDLE(uint32_t) stale = SLIST_POOL_ALLOC(uint32_t, pool);
+	SLIST_POOL_ADD(uint32_t, pool, list, stale);
+	SLIST_POOL_REMOVE(uint32_t, pool, list, stale);
+	SLIST_HANDLE(uint32_t) reused = SLIST_POOL_ALLOC(uint32_t, pool);
+	SLIST_POOL_ADD(uint32_t, pool, list, reused);
+	// Act
+	TEST_ASSERT_FALSE(SLIST_POOL_REMOVE(uint32_t, pool, list, stale));
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(SLIST_POOL_LOOKUP(uint32_t, pool, reused), list);
+}
+
+void test_WhenNodeReachedByTraversal_HandleOfMatches(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 2);
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_POOL_ALLOC(uint32_t, pool);
+	SLIST_HANDLE(uint32_t) handle = SLIST_POOL_ALLOC(uint32_t, pool);
+	SLIST_POOL_ADD(uint32_t, pool, list, handle);
+	// Act
+	SLIST_HANDLE(uint32_t) found = SLIST_POOL_HANDLE_OF(uint32_t, pool, list);
+	// Assert
+	TEST_ASSERT_EQUAL(handle.index, found.index);
+	TEST_ASSERT_EQUAL(handle.generation, found.generation);
+}
+
+void test_WhenNodeIsNotFromPool_HandleOfIsInvalid(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 2);
+	SLIST_NODE(uint32_t) foreign;
+	SLIST_POOL_ALLOC(uint32_t, pool);
+	// Act
+	SLIST_HANDLE(uint32_t) outside = SLIST_POOL_HANDLE_OF(uint32_t, pool, &foreign);
+	SLIST_HANDLE(uint32_t) unused = SLIST_POOL_HANDLE_OF(uint32_t, pool, &poolNodes[1]);
+	// Assert
+	TEST_ASSERT_FALSE(SLIST_POOL_IS_VALID(uint32_t, pool, outside));
+	TEST_ASSERT_FALSE(SLIST_POOL_IS_VALID(uint32_t, pool, unused));
+}
+
+void test_WhenNodeFreed_HandleOfIsInvalidAndCannotBeAdded(void)
+{
+	// Arrange
+	SLIST_CREATE_POOL(uint32_t, pool, 2);
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_HANDLE(uint32_t) handle = SLIST_POOL_ALLOC(uint32_t, pool);
+	SLIST_NODE(uint32_t)* node = SLIST_POOL_LOOKUP(uint32_t, pool, handle);
+	TEST_ASSERT_TRUE(SLIST_POOL_FREE(uint32_t, pool, handle));
+	// Act
+	SLIST_HANDLE(uint32_t) freed = SLIST_POOL_HANDLE_OF(uint32_t, pool, node);
+	// Assert
+	TEST_ASSERT_FALSE(SLIST_POOL_IS_VALID(uint32_t, pool, freed));
+	TEST_ASSERT_NULL(SLIST_POOL_LOOKUP(uint32_t, pool, freed));
+	TEST_ASSERT_FALSE(SLIST_POOL_ADD(uint32_t, pool, list, freed));
+	TEST_ASSERT_NULL(list);
+}
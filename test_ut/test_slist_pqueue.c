@@ -0,0 +1,82 @@
+#include "unity.h"
+#include "slist_pqueue_template.h"
+
+#include <stdint.h>
+
+
+#define LEVELS 64
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_PQUEUE_DECLARE_STATIC(uint32_t, LEVELS);
+SLIST_PQUEUE_DEFINE_STATIC(uint32_t, LEVELS);
+
+static SLIST_NODE(uint32_t) nodes[6];
+
+void setUp(void)
+{
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		nodes[i].data = i;
+	}
+}
+
+void test_WhenEmpty_PopReturnsNull(void)
+{
+	// Arrange
+	SLIST_CREATE_PQUEUE(uint32_t, LEVELS, queue);
+	// Act and assert
+	TEST_ASSERT_TRUE(SLIST_PQUEUE_IS_EMPTY(queue));
+	TEST_ASSERT_EQUAL(-1, SLIST_PQUEUE_TOP_PRIORITY(queue));
+	TEST_ASSERT_NULL(SLIST_PQUEUE_PEEK(uint32_t, LEVELS, queue));
+	TEST_ASSERT_NULL(SLIST_PQUEUE_POP(uint32_t, LEVELS, queue));
+}
+
+void test_WhenPriorityOutOfRange_PushIsRefused(void)
+{
+	// Arrange
+	SLIST_CREATE_PQUEUE(uint32_t, LEVELS, queue);
+	// Act and assert
+	TEST_ASSERT_FALSE(SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[0], LEVELS));
+	TEST_ASSERT_TRUE(SLIST_PQUEUE_IS_EMPTY(queue));
+}
+
+void test_WhenMixedPriorities_HighestComesFirstAndFifoWithinLevel(void)
+{
+	// Arrange
+	SLIST_CREATE_PQUEUE(uint32_t, LEVELS, queue);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[0], 1);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[1], 63);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[2], 1);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[3], 0);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[4], 63);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[5], 32);
+	TEST_ASSERT_EQUAL(6, SLIST_PQUEUE_COUNT(queue));
+	TEST_ASSERT_EQUAL(63, SLIST_PQUEUE_TOP_PRIORITY(queue));
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], SLIST_PQUEUE_PEEK(uint32_t, LEVELS, queue));
+	// Act and assert
+	static const uint32_t expected[] = { 1, 4, 5, 0, 2, 3 };
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		SLIST_NODE(uint32_t)* node = SLIST_PQUEUE_POP(uint32_t, LEVELS, queue);
+		TEST_ASSERT_NOT_NULL(node);
+		TEST_ASSERT_EQUAL(expected[i], node->data);
+	}
+	TEST_ASSERT_TRUE(SLIST_PQUEUE_IS_EMPTY(queue));
+	TEST_ASSERT_EQUAL(0, SLIST_PQUEUE_COUNT(queue));
+}
+
+void test_WhenLevelDrainedAndRefilled_NodeIsLinkedAgain(void)
+{
+	// Arrange
+	SLIST_CREATE_PQUEUE(uint32_t, LEVELS, queue);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[0], 7);
+	SLIST_PQUEUE_POP(uint32_t, LEVELS, queue);
+	// Act
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[1], 7);
+	SLIST_PQUEUE_PUSH(uint32_t, LEVELS, queue, nodes[2], 7);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], SLIST_PQUEUE_POP(uint32_t, LEVELS, queue));
+	TEST_ASSERT_EQUAL_PTR(&nodes[2], SLIST_PQUEUE_POP(uint32_t, LEVELS, queue));
+	TEST_ASSERT_NULL(SLIST_PQUEUE_POP(uint32_t, LEVELS, queue));
+}
@@ -0,0 +1,78 @@
+#include "unity.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+static char failure[256];
+static uint32_t seed;
+
+#define MODEL_CHECK(cond_) \
+do { \
+	if (!(cond_)) \
+	{ \
+		snprintf(failure, sizeof(failure), "seed %lu step %lu: %s", \
+			(unsigned long)seed, (unsigned long)modelStep, #cond_); \
+		TEST_FAIL_MESSAGE(failure); \
+	} \
+} while (0)
+
+#include "slist_model.h"
+
+#define SEQUENCES 2000u
+#define SEQUENCE_BYTES 512u
+
+/* Seeds are reported on failure, SLIST_PROPERTY_SEED replays a single one */
+static void fill(uint8_t* bytes, size_t size, uint32_t state)
+{
+	state = state * 2654435761u + 1u;
+	for (size_t i = 0; i < size; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		bytes[i] = (uint8_t)(state >> 24);
+	}
+}
+
+void test_WhenRandomSequencesApplied_ListsMatchModel(void)
+{
+	uint8_t bytes[SEQUENCE_BYTES];
+#ifdef SLIST_PROPERTY_SEED
+	seed = SLIST_PROPERTY_SEED;
+	fill(bytes, sizeof(bytes), seed);
+	model_run(bytes, sizeof(bytes));
+#else
+	for (seed = 1; seed <= SEQUENCES; seed++)
+	{
+		fill(bytes, sizeof(bytes), seed);
+		model_run(bytes, sizeof(bytes));
+	}
+#endif
+}
+
+void test_WhenArgumentsAreSmall_ListsMatchModel(void)
+{
+	// Arguments below 4 crowd the operations onto few nodes and short lists
+	uint8_t bytes[SEQUENCE_BYTES];
+	for (seed = 1; seed <= SEQUENCES / 4; seed++)
+	{
+		fill(bytes, sizeof(bytes), seed);
+		for (size_t i = 0; i < sizeof(bytes); i++)
+		{
+			bytes[i] = (i % 4 == 0) ? bytes[i] : (uint8_t)(bytes[i] & 0x03u);
+		}
+		model_run(bytes, sizeof(bytes));
+	}
+}
+
+void test_WhenInputTruncated_MissingArgumentsReadAsZero(void)
+{
+	// Arrange
+	const uint8_t bytes[] = { MODEL_ADD, 1, 7, MODEL_ADD };
+	seed = 0;
+	// Act
+	model_run(bytes, sizeof(bytes));
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&modelNodes[7], modelLists[1]);
+	TEST_ASSERT_EQUAL_PTR(&modelNodes[0], modelLists[0]);
+}
@@ -0,0 +1,100 @@
+#include "unity.h"
+#include "slist_template.h"
+
+#include <stdint.h>
+
+
+#define NODES 5
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_REORDER_STATIC(uint32_t);
+SLIST_DEFINE_REORDER_STATIC(uint32_t);
+
+static SLIST_NODE(uint32_t) nodes[NODES];
+static SLIST_NODE(uint32_t)* list;
+
+void setUp(void)
+{
+	list = NULL;
+	for (uint32_t i = 0; i < NODES; i++)
+	{
+		nodes[i].data = i;
+		SLIST_ADD_NODE(uint32_t, list, nodes[i]);
+	}
+}
+
+static void assert_list(SLIST_NODE(uint32_t)* head, const uint32_t* expected, size_t count)
+{
+	size_t at = 0;
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, head, node)
+	{
+		TEST_ASSERT_TRUE(at < count);
+		TEST_ASSERT_EQUAL(expected[at++], node->data);
+	}
+	TEST_ASSERT_EQUAL(count, at);
+}
+
+void test_WhenReversed_OrderIsInvertedAndOldHeadIsTail(void)
+{
+	// Act
+	SLIST_NODE(uint32_t)* tail = SLIST_REVERSE(uint32_t, list);
+	// Assert
+	static const uint32_t expected[] = { 4, 3, 2, 1, 0 };
+	assert_list(list, expected, NODES);
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], tail);
+}
+
+void test_WhenEmptyReversedOrRotated_NothingHappens(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, empty);
+	// Act / Assert
+	TEST_ASSERT_NULL(SLIST_REVERSE(uint32_t, empty));
+	TEST_ASSERT_NULL(SLIST_ROTATE(uint32_t, empty, 3));
+	TEST_ASSERT_NULL(SLIST_SPLIT_AT(uint32_t, empty, 0));
+	TEST_ASSERT_NULL(empty);
+}
+
+void test_WhenRotatedByK_FirstKNodesMoveToTheEnd(void)
+{
+	// Act
+	SLIST_NODE(uint32_t)* tail = SLIST_ROTATE(uint32_t, list, 2);
+	// Assert
+	static const uint32_t expected[] = { 2, 3, 4, 0, 1 };
+	assert_list(list, expected, NODES);
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], tail);
+}
+
+void test_WhenRotatedByLengthOrMore_KIsTakenModuloLength(void)
+{
+	// Act
+	SLIST_NODE(uint32_t)* tail = SLIST_ROTATE(uint32_t, list, NODES);
+	SLIST_ROTATE(uint32_t, list, 2 * NODES + 4);
+	// Assert
+	static const uint32_t expected[] = { 4, 0, 1, 2, 3 };
+	TEST_ASSERT_EQUAL_PTR(&nodes[NODES - 1], tail);
+	assert_list(list, expected, NODES);
+}
+
+void test_WhenSplitAtK_ListKeepsKNodesAndRestIsReturned(void)
+{
+	// Act
+	SLIST_NODE(uint32_t)* rest = SLIST_SPLIT_AT(uint32_t, list, 2);
+	// Assert
+	static const uint32_t kept[] = { 0, 1 };
+	static const uint32_t moved[] = { 2, 3, 4 };
+	assert_list(list, kept, 2);
+	assert_list(rest, moved, 3);
+}
+
+void test_WhenSplitOutsideTheList_NothingIsReturned(void)
+{
+	// Act
+	SLIST_NODE(uint32_t)* none = SLIST_SPLIT_AT(uint32_t, list, NODES);
+	SLIST_NODE(uint32_t)* all = SLIST_SPLIT_AT(uint32_t, list, 0);
+	// Assert
+	TEST_ASSERT_NULL(none);
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], all);
+	TEST_ASSERT_NULL(list);
+}
@@ -0,0 +1,54 @@
+#include "unity.h"
+#include "slist_split_template.h"
+
+#include <stdint.h>
+
+
+typedef struct {
+	uint8_t payload[200];
+} sRecord;
+
+#define KEY_EQ(a, b) (*(a) == *(b))
+
+SLIST_SPLIT_DECLARE_STATIC(sHot, uint32_t, sRecord);
+SLIST_SPLIT_DEFINE_STATIC(sHot, KEY_EQ);
+
+void test_WhenKeyPresent_FindReturnsNodeWithColdPart(void)
+{
+	// Arrange
+	static sRecord records[3];
+	SLIST_NODE(sHot) nodes[3];
+	SLIST_CREATE_LIST(sHot, list);
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		records[i].payload[0] = (uint8_t)(10 + i);
+		SLIST_SPLIT_BIND(nodes[i], 100 + i, &records[i]);
+		SLIST_ADD_NODE(sHot, list, nodes[i]);
+	}
+	// Act
+	SLIST_NODE(sHot)* found = SLIST_SPLIT_FIND(sHot, list, 101);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], found);
+	TEST_ASSERT_EQUAL(101, SLIST_SPLIT_KEY(found));
+	TEST_ASSERT_EQUAL(11, SLIST_SPLIT_COLD(found)->payload[0]);
+}
+
+void test_WhenKeyMissing_FindReturnsNull(void)
+{
+	// Arrange
+	static sRecord record;
+	SLIST_NODE(sHot) node;
+	SLIST_CREATE_LIST(sHot, list);
+	SLIST_SPLIT_BIND(node, 1, &record);
+	SLIST_ADD_NODE(sHot, list, node);
+	// Act / Assert
+	TEST_ASSERT_NULL(SLIST_SPLIT_FIND(sHot, list, 2));
+	TEST_ASSERT_NULL(SLIST_SPLIT_FIND(sHot, NULL, 1));
+}
+
+void test_WhenSplit_HotNodeStaysSmall(void)
+{
+	// Assert
+	TEST_ASSERT_TRUE(sizeof(SLIST_NODE(sHot)) <= SLIST_SPLIT_HOT_SIZE);
+	TEST_ASSERT_TRUE(sizeof(SLIST_NODE(sHot)) < sizeof(sRecord));
+}
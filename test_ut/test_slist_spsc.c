@@ -0,0 +1,72 @@
+#include "unity.h"
+#include "slist_spsc_template.h"
+
+#include <stdint.h>
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_SPSC_DECLARE_STATIC(uint32_t);
+SLIST_SPSC_DEFINE_STATIC(uint32_t)
+
+static SLIST_NODE(uint32_t) nodes[4];
+static SLIST_SPSC(uint32_t) queue;
+
+void setUp(void)
+{
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		nodes[i].data = i;
+		nodes[i].next = NULL;
+	}
+	SLIST_SPSC_INIT(uint32_t, queue);
+}
+
+void test_WhenQueueEmpty_PopReturnsNull(void)
+{
+	// Act & Assert
+	TEST_ASSERT_NULL(SLIST_SPSC_POP(uint32_t, queue));
+	TEST_ASSERT_NULL(SLIST_SPSC_POP(uint32_t, queue));
+}
+
+void test_WhenNodesPushed_TheyArePoppedInOrder(void)
+{
+	// Arrange
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		SLIST_SPSC_PUSH(uint32_t, queue, nodes[i]);
+	}
+	// Act & Assert
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		SLIST_NODE(uint32_t)* node = SLIST_SPSC_POP(uint32_t, queue);
+		TEST_ASSERT_EQUAL_PTR(&nodes[i], node);
+		TEST_ASSERT_NULL(node->next);
+	}
+	TEST_ASSERT_NULL(SLIST_SPSC_POP(uint32_t, queue));
+}
+
+void test_WhenLastNodePopped_ItCanBePushedAgain(void)
+{
+	// Arrange
+	SLIST_SPSC_PUSH(uint32_t, queue, nodes[0]);
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], SLIST_SPSC_POP(uint32_t, queue));
+	// Act
+	SLIST_SPSC_PUSH(uint32_t, queue, nodes[0]);
+	SLIST_SPSC_PUSH(uint32_t, queue, nodes[1]);
+	// Assert
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], SLIST_SPSC_POP(uint32_t, queue));
+	SLIST_SPSC_PUSH(uint32_t, queue, nodes[0]);
+	TEST_ASSERT_EQUAL_PTR(&nodes[1], SLIST_SPSC_POP(uint32_t, queue));
+	TEST_ASSERT_EQUAL_PTR(&nodes[0], SLIST_SPSC_POP(uint32_t, queue));
+	TEST_ASSERT_NULL(SLIST_SPSC_POP(uint32_t, queue));
+}
+
+void test_WhenQueueDeclared_ProducerAndConsumerUseDifferentLines(void)
+{
+	// Assert
+	size_t tail = (size_t)((char*)&queue.tail - (char*)&queue);
+	size_t head = (size_t)((char*)&queue.head - (char*)&queue);
+	TEST_ASSERT_TRUE(head - tail >= SLIST_CACHE_LINE);
+	TEST_ASSERT_EQUAL(0, (uintptr_t)&queue % SLIST_CACHE_LINE);
+}
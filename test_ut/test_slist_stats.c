@@ -0,0 +1,117 @@
+#define SLIST_ENABLE_STATS
+#define SLIST_STATS_PRINTF capture_printf
+
+#include "unity.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static char captured[256];
+
+static int capture_printf(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int written = vsnprintf(captured, sizeof(captured), format, args);
+	va_end(args);
+	return written;
+}
+
+#include "slist_template.h"
+
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+
+void setUp(void)
+{
+	SLIST_STATS_RESET(uint32_t);
+	captured[0] = '\0';
+}
+
+void test_WhenNoAdds_StatsAreZero(void)
+{
+	// Act and assert
+	TEST_ASSERT_EQUAL(0, SLIST_STATS(uint32_t)->adds);
+	TEST_ASSERT_EQUAL(0, SLIST_STATS(uint32_t)->duplicates);
+	TEST_ASSERT_EQUAL(0, SLIST_STATS(uint32_t)->steps);
+	TEST_ASSERT_EQUAL(0, SLIST_STATS(uint32_t)->max_walk);
+	TEST_ASSERT_EQUAL(0, SLIST_STATS(uint32_t)->max_length);
+}
+
+void test_WhenThreeNodesAdded_WalkAndLengthAreAccounted(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2, node3;
+	// Act
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	SLIST_ADD_NODE(uint32_t, list, node3);
+	// Assert
+	TEST_ASSERT_EQUAL(3, SLIST_STATS(uint32_t)->adds);
+	TEST_ASSERT_EQUAL(0, SLIST_STATS(uint32_t)->duplicates);
+	TEST_ASSERT_EQUAL(0 + 1 + 2, SLIST_STATS(uint32_t)->steps);
+	TEST_ASSERT_EQUAL(2, SLIST_STATS(uint32_t)->max_walk);
+	TEST_ASSERT_EQUAL(3, SLIST_STATS(uint32_t)->max_length);
+}
+
+void test_WhenNodeRepeated_DuplicateIsAccounted(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	// Act
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	// Assert
+	TEST_ASSERT_EQUAL(2, SLIST_STATS(uint32_t)->adds);
+	TEST_ASSERT_EQUAL(1, SLIST_STATS(uint32_t)->duplicates);
+	TEST_ASSERT_EQUAL(2, SLIST_STATS(uint32_t)->max_length);
+}
+
+void test_WhenListsAreShorter_HighWaterMarksAreKept(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, longList);
+	SLIST_CREATE_LIST(uint32_t, shortList);
+	SLIST_NODE(uint32_t) node1, node2, node3, node4;
+	SLIST_ADD_NODE(uint32_t, longList, node1);
+	SLIST_ADD_NODE(uint32_t, longList, node2);
+	SLIST_ADD_NODE(uint32_t, longList, node3);
+	// Act
+	SLIST_ADD_NODE(uint32_t, shortList, node4);
+	// Assert
+	TEST_ASSERT_EQUAL(2, SLIST_STATS(uint32_t)->max_walk);
+	TEST_ASSERT_EQUAL(3, SLIST_STATS(uint32_t)->max_length);
+}
+
+void test_WhenPopping_OnlyTakenNodesAreAccounted(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	// Act
+	SLIST_POP_NODE(uint32_t, list);
+	SLIST_POP_NODE(uint32_t, list);
+	// Assert
+	TEST_ASSERT_EQUAL(1, SLIST_STATS(uint32_t)->pops);
+}
+
+void test_WhenDumped_CountersArePrinted(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	// Act
+	SLIST_STATS_DUMP(uint32_t);
+	// Assert
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t>: adds=2 duplicates=1 steps=2 "
+		"max_walk=1 max_length=2 pops=0\n", captured);
+}
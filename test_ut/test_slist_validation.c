@@ -0,0 +1,251 @@
+#define SLIST_ENABLE_VALIDATION
+#define SLIST_ASSERT(expr_, msg_) ((expr_) ? (void)0 : validation_failed(msg_))
+
+#include "unity.h"
+#include <setjmp.h>
+#include <stdint.h>
+
+static jmp_buf recovery;
+static const char* failure;
+
+static void validation_failed(const char* msg)
+{
+	failure = msg;
+	// Carrying on would hang over the circular list
+	longjmp(recovery, 1);
+}
+
+#include "slist_template.h"
+#include "slist_pqueue_template.h"
+
+SLIST_DECLARE_STATIC(uint32_t);
+SLIST_DEFINE_STATIC(uint32_t);
+SLIST_DECLARE_BOUNDED_STATIC(uint32_t, 4);
+SLIST_DEFINE_BOUNDED_STATIC(uint32_t, 4);
+SLIST_DECLARE_COUNTED_STATIC(uint32_t);
+SLIST_DEFINE_COUNTED_STATIC(uint32_t);
+SLIST_PQUEUE_DECLARE_STATIC(uint32_t, 4);
+SLIST_PQUEUE_DEFINE_STATIC(uint32_t, 4);
+
+static int headReads;
+
+static SLIST_NODE(uint32_t)* read_head(SLIST_NODE(uint32_t)* head)
+{
+	headReads++;
+	return head;
+}
+
+void setUp(void)
+{
+	failure = NULL;
+	headReads = 0;
+}
+
+void test_WhenListIsEmpty_ItIsValid(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	// Act and assert
+	TEST_ASSERT_TRUE(SLIST_IS_VALID(uint32_t, list));
+}
+
+void test_WhenNodesAdded_ListStaysValid(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2, node3;
+	// Act
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	SLIST_ADD_NODE(uint32_t, list, node3);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	// Assert
+	TEST_ASSERT_TRUE(SLIST_IS_VALID(uint32_t, list));
+	TEST_ASSERT_NULL(failure);
+}
+
+void test_WhenNodePointsToItself_CycleIsDetected(void)
+{
+	// Arrange
+	SLIST_NODE(uint32_t) node1;
+	SLIST_NODE(uint32_t)* list = &node1;
+	node1.next = &node1;
+	// Act and assert
+	TEST_ASSERT_FALSE(SLIST_IS_VALID(uint32_t, list));
+}
+
+void test_WhenTailPointsBackIntoList_CycleIsDetected(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) nodes[7];
+	for (uint32_t i = 0; i < 7; i++)
+	{
+		SLIST_ADD_NODE(uint32_t, list, nodes[i]);
+	}
+	nodes[6].next = &nodes[3];
+	// Act and assert
+	TEST_ASSERT_FALSE(SLIST_IS_VALID(uint32_t, list));
+}
+
+void test_WhenAddingToCircularList_HookIsCalled(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2, node3;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	node2.next = &node1;
+	// Act
+	if (setjmp(recovery) == 0)
+	{
+		SLIST_ADD_NODE(uint32_t, list, node3);
+	}
+	// Assert
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t> is circular", failure);
+}
+
+void test_WhenTraversingCircularList_HookIsCalledBeforeFirstNode(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	node2.next = &node1;
+	// Act
+	if (setjmp(recovery) == 0)
+	{
+		SLIST_FOR_EACH_NODE_PTR(uint32_t, list, node)
+		{
+			TEST_FAIL();
+		}
+	}
+	// Assert
+	TEST_ASSERT_NOT_NULL(failure);
+}
+
+void test_WhenTraversing_HeadIsEvaluatedOnce(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	size_t visited = 0;
+	// Act
+	SLIST_FOR_EACH_NODE_PTR(uint32_t, read_head(list), node)
+	{
+		visited++;
+	}
+	// Assert
+	TEST_ASSERT_EQUAL(2, visited);
+	TEST_ASSERT_EQUAL(1, headReads);
+}
+
+void test_WhenPopLeavesCircularList_HookIsCalled(void)
+{
+	// Arrange
+	SLIST_CREATE_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2, node3;
+	SLIST_ADD_NODE(uint32_t, list, node1);
+	SLIST_ADD_NODE(uint32_t, list, node2);
+	SLIST_ADD_NODE(uint32_t, list, node3);
+	node3.next = &node2;
+	// Act
+	if (setjmp(recovery) == 0)
+	{
+		(void)SLIST_POP_NODE(uint32_t, list);
+	}
+	// Assert
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t> is circular", failure);
+}
+
+void test_WhenBoundedHeaderMatchesNodes_ItIsValid(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, 4, list, SLIST_DROP_OLDEST);
+	SLIST_NODE(uint32_t) nodes[6];
+	// Act
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		(void)SLIST_BOUNDED_ADD(uint32_t, 4, list, nodes[i]);
+	}
+	(void)SLIST_BOUNDED_POP(uint32_t, 4, list);
+	// Assert
+	TEST_ASSERT_TRUE(SLIST_BOUNDED_IS_VALID(uint32_t, 4, list));
+	TEST_ASSERT_NULL(failure);
+}
+
+void test_WhenBoundedCountIsWrong_HookIsCalled(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, 4, list, SLIST_DROP_NEW);
+	SLIST_NODE(uint32_t) node1, node2;
+	(void)SLIST_BOUNDED_ADD(uint32_t, 4, list, node1);
+	list.count = 2;
+	TEST_ASSERT_FALSE(SLIST_BOUNDED_IS_VALID(uint32_t, 4, list));
+	// Act
+	if (setjmp(recovery) == 0)
+	{
+		(void)SLIST_BOUNDED_ADD(uint32_t, 4, list, node2);
+	}
+	// Assert
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t> bounded header is inconsistent", failure);
+}
+
+void test_WhenBoundedTailIsWrong_ItIsNotValid(void)
+{
+	// Arrange
+	SLIST_CREATE_BOUNDED_LIST(uint32_t, 4, list, SLIST_DROP_NEW);
+	SLIST_NODE(uint32_t) node1, node2;
+	(void)SLIST_BOUNDED_ADD(uint32_t, 4, list, node1);
+	(void)SLIST_BOUNDED_ADD(uint32_t, 4, list, node2);
+	// Act
+	list.tail = &node1;
+	// Assert
+	TEST_ASSERT_FALSE(SLIST_BOUNDED_IS_VALID(uint32_t, 4, list));
+}
+
+void test_WhenCountedCountIsWrong_HookIsCalled(void)
+{
+	// Arrange
+	SLIST_CREATE_COUNTED_LIST(uint32_t, list);
+	SLIST_NODE(uint32_t) node1, node2;
+	SLIST_COUNTED_ADD(uint32_t, list, node1);
+	SLIST_COUNTED_ADD(uint32_t, list, node2);
+	TEST_ASSERT_TRUE(SLIST_COUNTED_IS_VALID(uint32_t, list));
+	list.count = 5;
+	// Act
+	if (setjmp(recovery) == 0)
+	{
+		(void)SLIST_COUNTED_POP(uint32_t, list);
+	}
+	// Assert
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t> counted header is inconsistent", failure);
+}
+
+void test_WhenPqueueLevelIsCircular_PushAndPopCallHook(void)
+{
+	// Arrange
+	SLIST_CREATE_PQUEUE(uint32_t, 4, queue);
+	SLIST_NODE(uint32_t) node1, node2, node3, node4;
+	(void)SLIST_PQUEUE_PUSH(uint32_t, 4, queue, node1, 2);
+	(void)SLIST_PQUEUE_PUSH(uint32_t, 4, queue, node2, 2);
+	(void)SLIST_PQUEUE_PUSH(uint32_t, 4, queue, node3, 2);
+	node2.next = &node2;
+	// Act
+	if (setjmp(recovery) == 0)
+	{
+		(void)SLIST_PQUEUE_POP(uint32_t, 4, queue);
+	}
+	const char* popFailure = failure;
+	failure = NULL;
+	if (setjmp(recovery) == 0)
+	{
+		(void)SLIST_PQUEUE_PUSH(uint32_t, 4, queue, node4, 2);
+	}
+	// Assert
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t> is circular", popFailure);
+	TEST_ASSERT_EQUAL_STRING("slist<uint32_t> is circular", failure);
+}